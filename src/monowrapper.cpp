@@ -1,6 +1,7 @@
 /* Mono includes */
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
+#include <mono/metadata/attrdefs.h>
 #include <mono/metadata/class.h>
 #include <mono/metadata/debug-helpers.h>
 #include <mono/metadata/loader.h>
@@ -10,11 +11,33 @@
 #include <mono/metadata/profiler.h>
 #include <mono/metadata/reflection.h>
 #include <mono/metadata/threads.h>
+#include <mono/metadata/tokentype.h>
 
 #include "monowrapper.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define MONOWRAPPER_SSE2 1
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #ifndef ASSERT
 #define ASSERT(x) assert(x)
@@ -38,6 +61,23 @@ MonoDomain* g_jitDomain;
 
 MonoProfiler g_monoProfiler;
 
+/* FindSystemClass cache. Misses are only valid for the assembly load generation they were recorded in */
+struct SystemClassEntry_t
+{
+	std::string ns;
+	std::string cls;
+	MonoClass* klass;
+	uint32_t generation;
+};
+
+/* Process-wide and looked up from any context, including the exception reporting path, so it's locked */
+static std::unordered_map<uint64_t, SystemClassEntry_t> g_systemClasses;
+static std::mutex g_systemClassMutex;
+static std::atomic<uint32_t> g_assemblyLoadGeneration{0};
+
+static void SystemClassCache_AssemblyLoaded(MonoAssembly* assembly, void* userData);
+static void SystemClassCache_Reset();
+
 /* Profiler methods */
 static void Profiler_RuntimeInit(MonoProfiler* prof);
 static void Profiler_RuntimeShutdownStart(MonoProfiler* prof);
@@ -54,13 +94,36 @@ static void Profiler_GCResize(MonoProfiler* prof, uintptr_t size);
 //
 //================================================================//
 ManagedAssembly::ManagedAssembly(ManagedScriptContext* ctx, const std::string& name, MonoImage* img, MonoAssembly* ass)
-	: m_ctx(ctx), m_path(name), m_image(img), m_assembly(ass), m_populated(false) {
+	: m_assembly(ass), m_image(img), m_path(name), m_populated(false), m_ctx(ctx) {
 }
 
-void ManagedAssembly::PopulateReflectionInfo() {
-	if (m_populated)
+/* If ownTypesOnly is set, types are wrapped straight into this assembly without going through
+ * the context, so it's safe to run on a worker thread before the assembly is published */
+void ManagedAssembly::PopulateReflectionInfo(bool ownTypesOnly) {
+	LoadReflectionCache();
+
+	/* Lazy contexts wrap classes as they're looked up instead */
+	if (m_populated || m_ctx->m_lazyReflection)
 		return;
 	m_populated = true;
+
+	auto wrap = [&](const char* ns, const char* c) {
+		if (ownTypesOnly)
+			m_ctx->FindClass(*this, ns, c);
+		else
+			m_ctx->FindClass(ns, c);
+	};
+
+	/* The cache already has every type name, so skip decoding the TYPEDEF table. Eager contexts still
+	 * resolve and populate each class through mono, only lazy ones defer that to the first lookup */
+	if (m_reflectionCache.Valid()) {
+		for (uint32_t i = 0; i < m_reflectionCache.TypeCount(); i++) {
+			const ReflectionCacheType_t& type = m_reflectionCache.Type(i);
+			wrap(m_reflectionCache.String(type.ns), m_reflectionCache.String(type.name));
+		}
+		return;
+	}
+
 	const MonoTableInfo* tab = mono_image_get_table_info(m_image, MONO_TABLE_TYPEDEF);
 	int rows = mono_table_info_get_rows(tab);
 	for (int i = 0; i < rows; i++) {
@@ -68,10 +131,21 @@ void ManagedAssembly::PopulateReflectionInfo() {
 		mono_metadata_decode_row(tab, i, cols, MONO_TYPEDEF_SIZE);
 		const char* ns = mono_metadata_string_heap(m_image, cols[MONO_TYPEDEF_NAMESPACE]);
 		const char* c = mono_metadata_string_heap(m_image, cols[MONO_TYPEDEF_NAME]);
-		m_ctx->FindClass(ns, c);
+		wrap(ns, c);
 	}
 }
 
+/* Maps this image's reflection cache, writing it first if there's none for this GUID yet */
+void ManagedAssembly::LoadReflectionCache() {
+	if (m_reflectionCache.Valid() || m_ctx->m_reflectionCacheDir.empty())
+		return;
+	std::string path = ManagedReflectionCache::PathFor(m_ctx->m_reflectionCacheDir, m_image);
+	if (m_reflectionCache.Open(path, m_image))
+		return;
+	if (ManagedReflectionCache::Write(path, m_image))
+		m_reflectionCache.Open(path, m_image);
+}
+
 /* NOTE: No info is cached here because it should be called sparingly! */
 void ManagedAssembly::GetReferencedTypes(std::vector<std::string>& refList) {
 	const MonoTableInfo* tab = mono_image_get_table_info(m_image, MONO_TABLE_TYPEREF);
@@ -106,10 +180,14 @@ bool ManagedAssembly::ValidateAgainstWhitelist(const std::vector<std::string>& w
 }
 
 void ManagedAssembly::DisposeReflectionInfo() {
+	m_ctx->InvalidateTypeIndex(this);
 	for (auto& kvPair : m_classes) {
-		delete kvPair.second;
+		Destroy(kvPair.second);
 	}
 	m_classes.clear();
+	m_arena.release();
+	m_reflectionCache.Close();
+	m_populated = false;
 }
 
 void ManagedAssembly::Unload() {
@@ -134,7 +212,7 @@ void ManagedAssembly::ReportException(MonoObject* exc) {
 //
 //================================================================//
 
-ManagedType::ManagedType(MonoType* type) : m_type(type) {
+ManagedType::ManagedType(MonoType* type, std::pmr::memory_resource* arena) : m_type(type), m_name(arena) {
 	m_isVoid = mono_type_is_void(type);
 	m_isStruct = mono_type_is_struct(type);
 	m_isRef = mono_type_is_reference(type);
@@ -145,10 +223,10 @@ bool ManagedType::Equals(const ManagedType* other) const {
 	return mono_type_get_type(m_type) == mono_type_get_type(other->m_type);
 }
 
-const std::string& ManagedType::Name() const {
+std::string_view ManagedType::Name() const {
 	if (m_name.empty()) {
 		char* c = mono_type_get_name(m_type);
-		m_name.copy(c, strlen(c));
+		const_cast<ManagedType*>(this)->m_name.assign(c);
 		mono_free(c);
 	}
 	return m_name;
@@ -160,11 +238,12 @@ const std::string& ManagedType::Name() const {
 //
 //================================================================//
 
-ManagedMethod::ManagedMethod(MonoMethod* method, ManagedClass* cls) : m_populated(false) {
+ManagedMethod::ManagedMethod(MonoMethod* method, ManagedClass* cls)
+	: m_attrInfo(nullptr), m_populated(false), m_attrInfoResolved(false), m_name(cls->Assembly().Arena()),
+	  m_thunk(nullptr), m_signatureHash(0), m_returnType(nullptr) {
 	if (!method)
 		return;
 	m_method = method;
-	m_attrInfo = mono_custom_attrs_from_method(method);
 	m_token = mono_method_get_token(method);
 	m_class = cls;
 	if (m_token) {
@@ -172,19 +251,18 @@ ManagedMethod::ManagedMethod(MonoMethod* method, ManagedClass* cls) : m_populate
 		ASSERT(m_signature);
 	}
 
-	m_name = mono_method_get_name(m_method);
+	m_name.assign(mono_method_get_name(m_method));
 	m_paramCount = mono_signature_get_param_count(m_signature);
-
-	m_returnType = new ManagedType(mono_signature_get_return_type(m_signature));
+	m_instance = mono_signature_is_instance(m_signature);
 }
 
 ManagedMethod::~ManagedMethod() {
 	if (m_attrInfo)
 		mono_custom_attrs_free(m_attrInfo);
-	if (m_returnType)
-		delete m_returnType;
+	ManagedAssembly& assembly = *m_class->m_assembly;
+	assembly.Destroy(m_returnType);
 	for (auto x : m_params) {
-		delete x;
+		assembly.Destroy(x);
 	}
 	m_params.clear();
 }
@@ -197,9 +275,25 @@ ManagedClass& ManagedMethod::Class() const {
 	return *m_class;
 }
 
+ManagedType& ManagedMethod::ReturnType() {
+	if (!m_returnType)
+		m_returnType = m_class->m_assembly->Allocate<ManagedType>(mono_signature_get_return_type(m_signature),
+																  m_class->m_assembly->Arena());
+	return *m_returnType;
+}
+
+MonoCustomAttrInfo* ManagedMethod::RawAttributeInfo() {
+	if (!m_attrInfoResolved) {
+		m_attrInfo = mono_custom_attrs_from_method(m_method);
+		m_attrInfoResolved = true;
+	}
+	return m_attrInfo;
+}
+
 void ManagedMethod::InvalidateHandle() {
 	ManagedBase::InvalidateHandle();
-	m_returnType->InvalidateHandle();
+	if (m_returnType)
+		m_returnType->InvalidateHandle();
 	for (auto& parm : m_params) {
 		parm->InvalidateHandle();
 	}
@@ -208,7 +302,7 @@ void ManagedMethod::InvalidateHandle() {
 	}
 }
 
-bool ManagedMethod::MatchSignature(MonoType* returnval, std::vector<MonoType*> params) {
+bool ManagedMethod::MatchSignature(MonoType* returnval, const std::vector<MonoType*>& params) {
 	/* Pre-verification that the params are likely to be equal */
 	if (m_paramCount != params.size()) {
 		return false;
@@ -230,7 +324,7 @@ bool ManagedMethod::MatchSignature(MonoType* returnval, std::vector<MonoType*> p
 	return true;
 }
 
-bool ManagedMethod::MatchSignature(std::vector<MonoType*> params) {
+bool ManagedMethod::MatchSignature(const std::vector<MonoType*>& params) {
 	if (m_paramCount != params.size()) {
 		return false;
 	}
@@ -264,6 +358,87 @@ bool ManagedMethod::MatchSignature() {
 	return mono_signature_get_param_count(m_signature) == 0;
 }
 
+void ManagedMethod::ReportException(MonoObject* exc) {
+	m_class->m_assembly->ReportException(exc);
+}
+
+void* ManagedMethod::UnmanagedThunk() {
+	if (!m_thunk)
+		m_thunk = mono_method_get_unmanaged_thunk(m_method);
+	return m_thunk;
+}
+
+/* Returns the type enum a parameter is passed as, with byrefs as pointers and enums as their base type */
+static MonoTypeEnum GetPassedTypeEnum(MonoType* type) {
+	if (mono_type_is_byref(type))
+		return MONO_TYPE_PTR;
+	MonoTypeEnum t = static_cast<MonoTypeEnum>(mono_type_get_type(type));
+	if (t == MONO_TYPE_VALUETYPE)
+		return static_cast<MonoTypeEnum>(mono_type_get_type(mono_type_get_underlying_type(type)));
+	if (t == MONO_TYPE_GENERICINST)
+		return mono_type_is_reference(type) ? MONO_TYPE_CLASS : MONO_TYPE_VALUETYPE;
+	return t;
+}
+
+/* size is the C++ size of a MONO_TYPE_VALUETYPE, which can't be told apart from other structs by its enum */
+static bool TypeEnumMatches(MonoTypeEnum expected, MonoType* type, size_t size = 0) {
+	MonoTypeEnum actual = GetPassedTypeEnum(type);
+	if (expected == MONO_TYPE_VALUETYPE && actual == MONO_TYPE_VALUETYPE) {
+		uint32_t align = 0;
+		return mono_class_value_size(mono_class_from_mono_type(type), &align) == static_cast<int32_t>(size);
+	}
+	if (expected == actual)
+		return true;
+	/* MonoObject* accepts any reference type, everything else must agree on the canonical type */
+	if (expected == MONO_TYPE_OBJECT)
+		return mono_type_is_reference(type) && !mono_type_is_byref(type);
+	if (expected == MONO_TYPE_STRING || expected == MONO_TYPE_SZARRAY || expected == MONO_TYPE_VALUETYPE)
+		return false;
+	return ManagedCanonicalTypeEnum(expected) == ManagedCanonicalTypeEnum(actual);
+}
+
+/* Compares each parameter and the return type. The caller has checked the count and the canonical hash */
+static bool SignatureTypesMatch(MonoMethodSignature* signature, const ManagedSignatureDesc_t& sig) {
+	if (!TypeEnumMatches(sig.returnType, mono_signature_get_return_type(signature), sig.returnSize))
+		return false;
+
+	void* iter = nullptr;
+	MonoType* type = nullptr;
+	int i = 0;
+	while ((type = mono_signature_get_params(signature, &iter))) {
+		if (!TypeEnumMatches(sig.params[i], type, sig.paramSizes[i]))
+			return false;
+		i++;
+	}
+	return true;
+}
+
+bool ManagedMethod::MatchSignature(const ManagedSignatureDesc_t& sig) {
+	if (m_paramCount != sig.paramCount || SignatureHash() != sig.canonicalHash)
+		return false;
+	return SignatureTypesMatch(m_signature, sig);
+}
+
+/* Same hash as HashSignature(..., true) over the signature's passed types */
+static uint64_t CanonicalSignatureHash(MonoMethodSignature* signature) {
+	uint64_t hash = HashCombine(0xcbf29ce484222325ULL,
+								ManagedCanonicalTypeEnum(GetPassedTypeEnum(mono_signature_get_return_type(signature))));
+	hash = HashCombine(hash, mono_signature_get_param_count(signature));
+
+	void* iter = nullptr;
+	MonoType* type = nullptr;
+	while ((type = mono_signature_get_params(signature, &iter))) {
+		hash = HashCombine(hash, ManagedCanonicalTypeEnum(GetPassedTypeEnum(type)));
+	}
+	return hash;
+}
+
+uint64_t ManagedMethod::SignatureHash() {
+	if (!m_signatureHash)
+		m_signatureHash = CanonicalSignatureHash(m_signature);
+	return m_signatureHash;
+}
+
 MonoObject* ManagedMethod::Invoke(ManagedObject* obj, void** params, MonoObject** _exc) {
 	MonoObject* exception = nullptr;
 	MonoObject* o = mono_runtime_invoke(m_method, obj->RawObject(), params, _exc ? _exc : &exception);
@@ -286,29 +461,851 @@ MonoObject* ManagedMethod::InvokeStatic(void** params, MonoObject** _exc) {
 	return o;
 }
 
+struct DelegateInvoke_t
+{
+	MonoMethod* invoke; // nullptr for classes that aren't delegates
+	void* thunk;
+	uint64_t signatureHash;
+};
+
+/* Keyed by delegate type. Delegates get bound from whichever thread fires the event, so it's locked */
+static std::unordered_map<MonoClass*, DelegateInvoke_t> g_delegateInvokes;
+static std::mutex g_delegateInvokeMutex;
+
+void* DelegateInvokeThunk(MonoClass* delegateClass, const ManagedSignatureDesc_t& sig) {
+	DelegateInvoke_t entry = {};
+	{
+		std::lock_guard<std::mutex> lock(g_delegateInvokeMutex);
+		auto it = g_delegateInvokes.find(delegateClass);
+		if (it == g_delegateInvokes.end()) {
+			if (mono_class_is_delegate(delegateClass))
+				entry.invoke = mono_get_delegate_invoke(delegateClass);
+			if (entry.invoke) {
+				entry.thunk = mono_method_get_unmanaged_thunk(entry.invoke);
+				entry.signatureHash = CanonicalSignatureHash(mono_method_signature(entry.invoke));
+			}
+			it = g_delegateInvokes.insert({delegateClass, entry}).first;
+		}
+		entry = it->second;
+	}
+
+	/* The canonical hash can't tell reference types or structs apart, so check the types as Bind does */
+	MonoMethodSignature* signature = entry.thunk ? mono_method_signature(entry.invoke) : nullptr;
+	if (!signature || entry.signatureHash != sig.canonicalHash ||
+		mono_signature_get_param_count(signature) != static_cast<uint32_t>(sig.paramCount) ||
+		!SignatureTypesMatch(signature, sig))
+		return nullptr;
+	return entry.thunk;
+}
+
+/* Called before images are closed. Everything goes, not just the image's own delegate types: generic
+ * instantiations such as Func<T> over one of its types belong to corlib's image. Thunks are cheap to resolve again */
+static void DelegateInvokeCache_Reset() {
+	std::lock_guard<std::mutex> lock(g_delegateInvokeMutex);
+	g_delegateInvokes.clear();
+}
+
+//================================================================//
+//
+// Managed Mapped File
+//
+//================================================================//
+
+ManagedMappedFile::ManagedMappedFile() : m_data(nullptr), m_size(0), m_mapping(nullptr) {
+}
+
+ManagedMappedFile::~ManagedMappedFile() {
+	Close();
+}
+
+bool ManagedMappedFile::Open(const char* path) {
+	Close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+							  nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data) {
+		CloseHandle(mapping);
+		return false;
+	}
+	m_mapping = mapping;
+	m_size = static_cast<size_t>(size.QuadPart);
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return false;
+	}
+	void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+	m_size = static_cast<size_t>(st.st_size);
+#endif
+	m_data = static_cast<const char*>(data);
+	return true;
+}
+
+void ManagedMappedFile::Close() {
+	if (!m_data)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mapping);
+	m_mapping = nullptr;
+#else
+	munmap(const_cast<char*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+/* Creates a file next to path under a name no other writer is using. Written files are renamed over path */
+static FILE* OpenTempFileFor(const std::string& path, std::string& tmpPath) {
+#ifdef _WIN32
+	static std::atomic<uint32_t> counter{0};
+	for (int attempt = 0; attempt < 16; attempt++) {
+		tmpPath = path + "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(counter.fetch_add(1)) +
+				  ".tmp";
+		if (FILE* fp = fopen(tmpPath.c_str(), "wbx"))
+			return fp;
+	}
+	return nullptr;
+#else
+	tmpPath = path + ".XXXXXX";
+	int fd = mkstemp(&tmpPath[0]);
+	if (fd < 0)
+		return nullptr;
+	/* mkstemp creates the file owner-only, the final file should be as readable as a plain fopen would make it */
+	fchmod(fd, 0644);
+	FILE* fp = fdopen(fd, "wb");
+	if (!fp) {
+		close(fd);
+		remove(tmpPath.c_str());
+	}
+	return fp;
+#endif
+}
+
+//================================================================//
+//
+// Managed Reflection Cache
+//
+//================================================================//
+
+static_assert(sizeof(ReflectionCacheHeader_t) == 64, "Reflection cache layout changed, bump the version");
+static_assert(sizeof(ReflectionCacheType_t) == 32, "Reflection cache layout changed, bump the version");
+static_assert(sizeof(ReflectionCacheMember_t) == 32, "Reflection cache layout changed, bump the version");
+
+static const char g_reflectionCacheMagic[4] = {'M', 'W', 'R', 'C'};
+
+ManagedReflectionCache::ManagedReflectionCache()
+	: m_header(nullptr), m_types(nullptr), m_members(nullptr), m_strings(nullptr) {
+}
+
+std::string ManagedReflectionCache::PathFor(const std::string& dir, MonoImage* image) {
+	std::string path = dir;
+	if (!path.empty() && path.back() != '/' && path.back() != '\\')
+		path += '/';
+	path += mono_image_get_guid(image);
+	path += ".mwrc";
+	return path;
+}
+
+bool ManagedReflectionCache::Write(const std::string& path, MonoImage* image) {
+	const char* guid = mono_image_get_guid(image);
+	if (!guid || strlen(guid) >= sizeof(ReflectionCacheHeader_t::guid))
+		return false;
+
+	std::vector<ReflectionCacheType_t> types;
+	std::vector<ReflectionCacheMember_t> members;
+	std::string strings(1, '\0'); // Offset 0 is the empty string
+	std::unordered_map<std::string_view, uint32_t> stringOffsets;
+
+	auto addString = [&](const char* str) -> uint32_t {
+		if (!str || !*str)
+			return 0;
+		auto it = stringOffsets.find(str);
+		if (it != stringOffsets.end())
+			return it->second;
+		uint32_t offset = static_cast<uint32_t>(strings.size());
+		strings.append(str, strlen(str) + 1);
+		stringOffsets.insert({str, offset}); // Views into mono's heaps, which outlive this
+		return offset;
+	};
+
+	const MonoTableInfo* tab = mono_image_get_table_info(image, MONO_TABLE_TYPEDEF);
+	int rows = mono_table_info_get_rows(tab);
+	for (int i = 0; i < rows; i++) {
+		uint32_t cols[MONO_TYPEDEF_SIZE];
+		mono_metadata_decode_row(tab, i, cols, MONO_TYPEDEF_SIZE);
+		const char* ns = mono_metadata_string_heap(image, cols[MONO_TYPEDEF_NAMESPACE]);
+		const char* name = mono_metadata_string_heap(image, cols[MONO_TYPEDEF_NAME]);
+
+		ReflectionCacheType_t type{};
+		type.hash = HashTypeName(ns, name);
+		type.ns = addString(ns);
+		type.name = addString(name);
+		type.token = MONO_TOKEN_TYPE_DEF | (i + 1);
+		type.firstMember = static_cast<uint32_t>(members.size());
+
+		MonoClass* klass = mono_class_get(image, type.token);
+		if (klass) {
+			void* iter = nullptr;
+			MonoMethod* method;
+			while ((method = mono_class_get_methods(klass, &iter))) {
+				MonoMethodSignature* signature = mono_method_signature(method);
+				const char* methodName = mono_method_get_name(method);
+				ReflectionCacheMember_t m{};
+				m.hash = HashString(methodName);
+				m.signatureHash = signature ? CanonicalSignatureHash(signature) : 0;
+				m.name = addString(methodName);
+				m.token = mono_method_get_token(method);
+				m.arity = signature ? static_cast<uint16_t>(mono_signature_get_param_count(signature)) : 0;
+				m.kind = CACHE_MEMBER_METHOD;
+				members.push_back(m);
+			}
+
+			iter = nullptr;
+			MonoClassField* field;
+			while ((field = mono_class_get_fields(klass, &iter))) {
+				const char* fieldName = mono_field_get_name(field);
+				ReflectionCacheMember_t m{};
+				m.hash = HashString(fieldName);
+				m.name = addString(fieldName);
+				m.token = mono_class_get_field_token(field);
+				m.kind = CACHE_MEMBER_FIELD;
+				members.push_back(m);
+			}
+		}
+
+		type.memberCount = static_cast<uint32_t>(members.size()) - type.firstMember;
+		types.push_back(type);
+	}
+
+	std::stable_sort(types.begin(), types.end(),
+					 [](const ReflectionCacheType_t& a, const ReflectionCacheType_t& b) { return a.hash < b.hash; });
+
+	ReflectionCacheHeader_t header{};
+	memcpy(header.magic, g_reflectionCacheMagic, sizeof(header.magic));
+	header.version = Version;
+	strncpy(header.guid, guid, sizeof(header.guid) - 1);
+	header.typeCount = static_cast<uint32_t>(types.size());
+	header.memberCount = static_cast<uint32_t>(members.size());
+	header.stringsSize = static_cast<uint32_t>(strings.size());
+
+	/* Write next to the final file and rename it over, so readers never see a partial cache */
+	std::string tmpPath;
+	FILE* fp = OpenTempFileFor(path, tmpPath);
+	if (!fp)
+		return false;
+	bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+	ok = ok && fwrite(types.data(), sizeof(ReflectionCacheType_t), types.size(), fp) == types.size();
+	ok = ok && fwrite(members.data(), sizeof(ReflectionCacheMember_t), members.size(), fp) == members.size();
+	ok = ok && fwrite(strings.data(), 1, strings.size(), fp) == strings.size();
+	ok = fclose(fp) == 0 && ok;
+#ifdef _WIN32
+	if (ok)
+		remove(path.c_str());
+#endif
+	if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+		remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool ManagedReflectionCache::Open(const std::string& path, MonoImage* image) {
+	Close();
+	if (!m_file.Open(path.c_str()))
+		return false;
+
+	const char* data = m_file.Data();
+	auto header = reinterpret_cast<const ReflectionCacheHeader_t*>(data);
+	const char* guid = mono_image_get_guid(image);
+	if (m_file.Size() < sizeof(*header) || memcmp(header->magic, g_reflectionCacheMagic, sizeof(header->magic)) ||
+		header->version != Version || !guid || strncmp(header->guid, guid, sizeof(header->guid)) != 0) {
+		m_file.Close();
+		return false;
+	}
+
+	uint64_t expected = sizeof(*header) + uint64_t(header->typeCount) * sizeof(ReflectionCacheType_t) +
+						uint64_t(header->memberCount) * sizeof(ReflectionCacheMember_t) + header->stringsSize;
+	if (expected != m_file.Size()) {
+		m_file.Close();
+		return false;
+	}
+
+	m_types = reinterpret_cast<const ReflectionCacheType_t*>(data + sizeof(*header));
+	m_members = reinterpret_cast<const ReflectionCacheMember_t*>(m_types + header->typeCount);
+	m_strings = reinterpret_cast<const char*>(m_members + header->memberCount);
+
+	/* Reject anything that would index out of the mapping later */
+	for (uint32_t i = 0; i < header->typeCount; i++) {
+		const ReflectionCacheType_t& type = m_types[i];
+		if (uint64_t(type.firstMember) + type.memberCount > header->memberCount) {
+			m_file.Close();
+			return false;
+		}
+	}
+	if (header->stringsSize == 0 || m_strings[header->stringsSize - 1] != '\0') {
+		m_file.Close();
+		return false;
+	}
+
+	m_header = header;
+	return true;
+}
+
+void ManagedReflectionCache::Close() {
+	m_file.Close();
+	m_header = nullptr;
+	m_types = nullptr;
+	m_members = nullptr;
+	m_strings = nullptr;
+}
+
+const ReflectionCacheType_t* ManagedReflectionCache::FindType(std::string_view ns, std::string_view cls) const {
+	if (!m_header)
+		return nullptr;
+	uint64_t hash = HashTypeName(ns, cls);
+	const ReflectionCacheType_t* end = m_types + m_header->typeCount;
+	const ReflectionCacheType_t* it = std::lower_bound(
+		m_types, end, hash, [](const ReflectionCacheType_t& type, uint64_t h) { return type.hash < h; });
+	for (; it != end && it->hash == hash; ++it) {
+		if (ns == String(it->ns) && cls == String(it->name))
+			return it;
+	}
+	return nullptr;
+}
+
+//================================================================//
+//
+// Managed Script Bundle
+//
+//================================================================//
+
+static_assert(sizeof(ScriptBundleHeader_t) == 16, "Script bundle layout changed, bump the version");
+static_assert(sizeof(ScriptBundleEntry_t) == 72, "Script bundle layout changed, bump the version");
+
+static const char g_scriptBundleMagic[4] = {'M', 'W', 'B', 'N'};
+
+static constexpr uint64_t ScriptBundleAlign(uint64_t offset) {
+	return (offset + 15) & ~uint64_t(15);
+}
+
+ManagedScriptBundle::ManagedScriptBundle() : m_header(nullptr), m_entries(nullptr), m_strings(nullptr) {
+}
+
+bool ManagedScriptBundle::Write(const std::string& path, const std::vector<std::string>& assemblies) {
+	struct Pending_t
+	{
+		std::string name;
+		std::vector<char> data;
+		ScriptBundleEntry_t entry;
+	};
+	std::vector<Pending_t> pending(assemblies.size());
+	std::string strings(1, '\0');
+
+	for (size_t i = 0; i < assemblies.size(); i++) {
+		Pending_t& p = pending[i];
+		FILE* fp = fopen(assemblies[i].c_str(), "rb");
+		if (!fp)
+			return false;
+		fseek(fp, 0, SEEK_END);
+		long size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		p.data.resize(size > 0 ? size : 0);
+		bool ok = size > 0 && fread(p.data.data(), 1, p.data.size(), fp) == p.data.size();
+		fclose(fp);
+		if (!ok || p.data.size() > UINT32_MAX)
+			return false;
+
+		/* Name the entry after the assembly, that's what references ask for */
+		MonoImageOpenStatus status = MONO_IMAGE_OK;
+		MonoImage* img = mono_image_open_from_data_with_name(p.data.data(), static_cast<uint32_t>(p.data.size()), true,
+															 &status, false, assemblies[i].c_str());
+		if (!img)
+			return false;
+		const char* guid = mono_image_get_guid(img);
+		p.name = mono_image_get_name(img);
+		p.entry = {};
+		strncpy(p.entry.guid, guid ? guid : "", sizeof(p.entry.guid) - 1);
+		mono_image_close(img);
+
+		p.entry.hash = HashString(p.name);
+		p.entry.size = p.data.size();
+		p.entry.name = static_cast<uint32_t>(strings.size());
+		strings.append(p.name.c_str(), p.name.size() + 1);
+	}
+
+	std::sort(pending.begin(), pending.end(),
+			  [](const Pending_t& a, const Pending_t& b) { return a.entry.hash < b.entry.hash; });
+
+	uint64_t offset = ScriptBundleAlign(sizeof(ScriptBundleHeader_t) + pending.size() * sizeof(ScriptBundleEntry_t) +
+										strings.size());
+	for (auto& p : pending) {
+		p.entry.offset = offset;
+		offset = ScriptBundleAlign(offset + p.entry.size);
+	}
+
+	ScriptBundleHeader_t header{};
+	memcpy(header.magic, g_scriptBundleMagic, sizeof(header.magic));
+	header.version = Version;
+	header.entryCount = static_cast<uint32_t>(pending.size());
+	header.stringsSize = static_cast<uint32_t>(strings.size());
+
+	std::string tmpPath;
+	FILE* fp = OpenTempFileFor(path, tmpPath);
+	if (!fp)
+		return false;
+	static const char padding[16] = {};
+	bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+	for (auto& p : pending)
+		ok = ok && fwrite(&p.entry, sizeof(p.entry), 1, fp) == 1;
+	ok = ok && fwrite(strings.data(), 1, strings.size(), fp) == strings.size();
+	for (auto& p : pending) {
+		long pos = ftell(fp);
+		ok = ok && pos >= 0 && fwrite(padding, 1, p.entry.offset - pos, fp) == p.entry.offset - pos;
+		ok = ok && fwrite(p.data.data(), 1, p.data.size(), fp) == p.data.size();
+	}
+	ok = fclose(fp) == 0 && ok;
+#ifdef _WIN32
+	if (ok)
+		remove(path.c_str());
+#endif
+	if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+		remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool ManagedScriptBundle::Open(const std::string& path) {
+	if (!m_file.Open(path.c_str()))
+		return false;
+
+	const char* data = m_file.Data();
+	auto header = reinterpret_cast<const ScriptBundleHeader_t*>(data);
+	if (m_file.Size() < sizeof(*header) || memcmp(header->magic, g_scriptBundleMagic, sizeof(header->magic)) ||
+		header->version != Version) {
+		m_file.Close();
+		return false;
+	}
+
+	uint64_t tableEnd =
+		sizeof(*header) + uint64_t(header->entryCount) * sizeof(ScriptBundleEntry_t) + header->stringsSize;
+	if (tableEnd > m_file.Size() || header->stringsSize == 0) {
+		m_file.Close();
+		return false;
+	}
+
+	auto entries = reinterpret_cast<const ScriptBundleEntry_t*>(data + sizeof(*header));
+	auto strings = reinterpret_cast<const char*>(entries + header->entryCount);
+	if (strings[header->stringsSize - 1] != '\0') {
+		m_file.Close();
+		return false;
+	}
+	for (uint32_t i = 0; i < header->entryCount; i++) {
+		const ScriptBundleEntry_t& entry = entries[i];
+		if (entry.offset < tableEnd || entry.size > UINT32_MAX || entry.offset > m_file.Size() ||
+			entry.size > m_file.Size() - entry.offset) {
+			m_file.Close();
+			return false;
+		}
+	}
+
+	m_path = path;
+	m_header = header;
+	m_entries = entries;
+	m_strings = strings;
+	return true;
+}
+
+const ScriptBundleEntry_t* ManagedScriptBundle::Find(std::string_view name) const {
+	if (!m_header)
+		return nullptr;
+	uint64_t hash = HashString(name);
+	const ScriptBundleEntry_t* end = m_entries + m_header->entryCount;
+	const ScriptBundleEntry_t* it = std::lower_bound(
+		m_entries, end, hash, [](const ScriptBundleEntry_t& entry, uint64_t h) { return entry.hash < h; });
+	for (; it != end && it->hash == hash; ++it) {
+		if (name == Name(*it))
+			return it;
+	}
+	return nullptr;
+}
+
+MonoAssembly* ManagedScriptBundle::Load(std::string_view name) {
+	const ScriptBundleEntry_t* entry = Find(name);
+	if (!entry)
+		return nullptr;
+	uint32_t index = static_cast<uint32_t>(entry - m_entries);
+
+	std::lock_guard<std::recursive_mutex> lock(m_loadMutex);
+	auto it = m_loaded.find(index);
+	if (it != m_loaded.end())
+		return it->second;
+
+	/* Images are named after the bundle, so the same assembly from two bundles doesn't collide */
+	std::string imageName = m_path + ":" + Name(*entry);
+	MonoImageOpenStatus status = MONO_IMAGE_OK;
+	MonoImage* img = mono_image_open_from_data_with_name(const_cast<char*>(Data(*entry)),
+														 static_cast<uint32_t>(entry->size), false, &status, false,
+														 imageName.c_str());
+	if (!img || status != MONO_IMAGE_OK)
+		return nullptr;
+	MonoAssembly* ass = mono_assembly_load_from_full(img, imageName.c_str(), &status, false);
+	if (!ass || status != MONO_IMAGE_OK) {
+		mono_image_close(img);
+		return nullptr;
+	}
+	m_loaded.insert({index, ass});
+	return ass;
+}
+
 //================================================================//
 //
 // Managed Field
 //
 //================================================================//
 
-ManagedField::ManagedField(MonoClassField& fld, ManagedClass& cls) : m_class(cls), m_field(fld) {
-	const char* n = mono_field_get_name(&fld);
-	m_name = n;
+ManagedField::ManagedField(MonoClassField& fld, ManagedClass& cls)
+	: m_field(fld), m_class(cls), m_name(mono_field_get_name(&fld), cls.Assembly().Arena()) {
 }
 
 ManagedField::~ManagedField() {
 }
 
+bool ManagedField::IsStatic() const {
+	return mono_field_get_flags(&m_field) & MONO_FIELD_ATTR_STATIC;
+}
+
+MonoVTable* ManagedField::StaticVTable() const {
+	if (!IsStatic())
+		return nullptr;
+	MonoVTable* vtable = m_class.VTable();
+	if (vtable)
+		mono_runtime_class_init(vtable);
+	return vtable;
+}
+
+uint32_t ManagedField::Offset() const {
+	return mono_field_get_offset(&m_field);
+}
+
+bool ManagedField::MatchType(MonoTypeEnum expected, size_t size) const {
+	return TypeEnumMatches(expected, mono_field_get_type(&m_field), size);
+}
+
+//================================================================//
+//
+// Managed Array
+//
+//================================================================//
+
+MonoClass* ManagedPrimitiveClass(MonoTypeEnum type) {
+	switch (type) {
+	case MONO_TYPE_BOOLEAN:
+		return mono_get_boolean_class();
+	case MONO_TYPE_CHAR:
+		return mono_get_char_class();
+	case MONO_TYPE_I1:
+		return mono_get_sbyte_class();
+	case MONO_TYPE_U1:
+		return mono_get_byte_class();
+	case MONO_TYPE_I2:
+		return mono_get_int16_class();
+	case MONO_TYPE_U2:
+		return mono_get_uint16_class();
+	case MONO_TYPE_I4:
+		return mono_get_int32_class();
+	case MONO_TYPE_U4:
+		return mono_get_uint32_class();
+	case MONO_TYPE_I8:
+		return mono_get_int64_class();
+	case MONO_TYPE_U8:
+		return mono_get_uint64_class();
+	case MONO_TYPE_R4:
+		return mono_get_single_class();
+	case MONO_TYPE_R8:
+		return mono_get_double_class();
+	case MONO_TYPE_STRING:
+		return mono_get_string_class();
+	case MONO_TYPE_OBJECT:
+		return mono_get_object_class();
+	default:
+		return nullptr;
+	}
+}
+
+struct ArrayVTableKey_t
+{
+	MonoDomain* domain;
+	MonoClass* element;
+
+	bool operator==(const ArrayVTableKey_t& other) const {
+		return domain == other.domain && element == other.element;
+	}
+};
+
+struct ArrayVTableKeyHash_t
+{
+	size_t operator()(const ArrayVTableKey_t& key) const {
+		return HashCombine(reinterpret_cast<uintptr_t>(key.domain), reinterpret_cast<uintptr_t>(key.element));
+	}
+};
+
+static std::unordered_map<ArrayVTableKey_t, MonoVTable*, ArrayVTableKeyHash_t> g_arrayVTables;
+static std::mutex g_arrayVTableMutex;
+
+MonoArray* NewManagedArray(MonoClass* elementClass, size_t length) {
+	MonoDomain* domain = mono_domain_get();
+	MonoVTable* vtable = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(g_arrayVTableMutex);
+		MonoVTable*& cached = g_arrayVTables[{domain, elementClass}];
+		if (!cached)
+			cached = mono_class_vtable(domain, mono_array_class_get(elementClass, 1));
+		vtable = cached;
+	}
+	return vtable ? mono_array_new_specific(vtable, length) : nullptr;
+}
+
+/* Called before images are closed, the element classes and their array vtables may go with them */
+static void ArrayVTableCache_Reset() {
+	std::lock_guard<std::mutex> lock(g_arrayVTableMutex);
+	g_arrayVTables.clear();
+}
+
+void ConvertLatin1ToUtf16(const char* src, char16_t* dst, size_t count) {
+	size_t i = 0;
+#ifdef MONOWRAPPER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= count; i += 16) {
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+	}
+#endif
+	for (; i < count; i++)
+		dst[i] = static_cast<uint8_t>(src[i]);
+}
+
+void ConvertUtf16ToLatin1(const char16_t* src, char* dst, size_t count) {
+	size_t i = 0;
+#ifdef MONOWRAPPER_SSE2
+	/* packus saturates signed words, which would turn U+8000 and up into 0, so clamp to 0xFF first */
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i max = _mm_set1_epi16(0xFF);
+	auto clamp = [&](__m128i v) {
+		__m128i inRange = _mm_cmpeq_epi16(_mm_srli_epi16(v, 8), zero);
+		return _mm_or_si128(_mm_and_si128(inRange, v), _mm_andnot_si128(inRange, max));
+	};
+	for (; i + 16 <= count; i += 16) {
+		__m128i lo = clamp(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+		__m128i hi = clamp(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < count; i++)
+		dst[i] = static_cast<char>(src[i] > 0xFF ? 0xFF : src[i]);
+}
+
+void NormalizeBools(const bool* src, bool* dst, size_t count) {
+	auto in = reinterpret_cast<const uint8_t*>(src);
+	auto out = reinterpret_cast<uint8_t*>(dst);
+	size_t i = 0;
+#ifdef MONOWRAPPER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi8(1);
+	for (; i + 16 <= count; i += 16) {
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+		__m128i isZero = _mm_cmpeq_epi8(bytes, zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_andnot_si128(isZero, one));
+	}
+#endif
+	for (; i < count; i++)
+		out[i] = in[i] != 0;
+}
+
+//================================================================//
+//
+// Managed Strings
+//
+//================================================================//
+
+/* Decodes one code point starting at src[i], advancing i. Returns U+FFFD for invalid sequences */
+static uint32_t DecodeUtf8(const uint8_t* src, size_t len, size_t& i) {
+	uint8_t c = src[i++];
+	if (c < 0x80)
+		return c;
+
+	int extra;
+	uint32_t cp, min;
+	if ((c & 0xE0) == 0xC0) {
+		extra = 1, cp = c & 0x1F, min = 0x80;
+	}
+	else if ((c & 0xF0) == 0xE0) {
+		extra = 2, cp = c & 0x0F, min = 0x800;
+	}
+	else if ((c & 0xF8) == 0xF0) {
+		extra = 3, cp = c & 0x07, min = 0x10000;
+	}
+	else {
+		return 0xFFFD;
+	}
+
+	if (len - i < static_cast<size_t>(extra))
+		return 0xFFFD;
+	for (int k = 0; k < extra; k++) {
+		if ((src[i + k] & 0xC0) != 0x80)
+			return 0xFFFD;
+		cp = (cp << 6) | (src[i + k] & 0x3F);
+	}
+	if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+		return 0xFFFD;
+	i += extra;
+	return cp;
+}
+
+size_t Utf8ToUtf16(const char* src, size_t len, char16_t* dst) {
+	auto in = reinterpret_cast<const uint8_t*>(src);
+	size_t i = 0, out = 0;
+	while (i < len) {
+#ifdef MONOWRAPPER_SSE2
+		/* Widen runs of ASCII 16 bytes at a time */
+		const __m128i zero = _mm_setzero_si128();
+		while (len - i >= 16) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			if (_mm_movemask_epi8(bytes))
+				break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + out), _mm_unpacklo_epi8(bytes, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + out + 8), _mm_unpackhi_epi8(bytes, zero));
+			i += 16;
+			out += 16;
+		}
+		if (i >= len)
+			break;
+#endif
+		uint32_t cp = DecodeUtf8(in, len, i);
+		if (cp >= 0x10000) {
+			cp -= 0x10000;
+			dst[out++] = static_cast<char16_t>(0xD800 + (cp >> 10));
+			dst[out++] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+		}
+		else {
+			dst[out++] = static_cast<char16_t>(cp);
+		}
+	}
+	return out;
+}
+
+size_t Utf16ToUtf8(const char16_t* src, size_t len, char* dst) {
+	auto out = reinterpret_cast<uint8_t*>(dst);
+	size_t i = 0, n = 0;
+	while (i < len) {
+#ifdef MONOWRAPPER_SSE2
+		/* Narrow runs of ASCII 8 units at a time */
+		const __m128i asciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+		while (len - i >= 8) {
+			__m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, asciiMask), _mm_setzero_si128())) != 0xFFFF)
+				break;
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + n), _mm_packus_epi16(units, units));
+			i += 8;
+			n += 8;
+		}
+		if (i >= len)
+			break;
+#endif
+		uint32_t cp = src[i++];
+		if (cp >= 0xD800 && cp <= 0xDBFF && i < len && src[i] >= 0xDC00 && src[i] <= 0xDFFF)
+			cp = 0x10000 + ((cp - 0xD800) << 10) + (src[i++] - 0xDC00);
+		else if (cp >= 0xD800 && cp <= 0xDFFF)
+			cp = 0xFFFD;
+
+		if (cp < 0x80) {
+			out[n++] = static_cast<uint8_t>(cp);
+		}
+		else if (cp < 0x800) {
+			out[n++] = static_cast<uint8_t>(0xC0 | (cp >> 6));
+			out[n++] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+		}
+		else if (cp < 0x10000) {
+			out[n++] = static_cast<uint8_t>(0xE0 | (cp >> 12));
+			out[n++] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+			out[n++] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+		}
+		else {
+			out[n++] = static_cast<uint8_t>(0xF0 | (cp >> 18));
+			out[n++] = static_cast<uint8_t>(0x80 | ((cp >> 12) & 0x3F));
+			out[n++] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+			out[n++] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+		}
+	}
+	return n;
+}
+
+MonoString* NewManagedString(std::string_view utf8) {
+	char16_t stackBuf[256];
+	std::vector<char16_t> heapBuf;
+	char16_t* buf = stackBuf;
+	if (utf8.size() > sizeof(stackBuf) / sizeof(stackBuf[0])) {
+		heapBuf.resize(utf8.size());
+		buf = heapBuf.data();
+	}
+	size_t len = Utf8ToUtf16(utf8.data(), utf8.size(), buf);
+	return mono_string_new_utf16(mono_domain_get(), reinterpret_cast<const mono_unichar2*>(buf),
+								 static_cast<int32_t>(len));
+}
+
+std::string ToUtf8(MonoString* str) {
+	std::u16string_view chars = StringView(str);
+	std::string out(chars.size() * 3, '\0');
+	out.resize(Utf16ToUtf8(chars.data(), chars.size(), out.data()));
+	return out;
+}
+
+MonoString* ManagedStringCache::Get(std::string_view str) {
+	uint64_t hash = HashString(str);
+	auto range = m_strings.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second.value == str)
+			return reinterpret_cast<MonoString*>(it->second.string.Get());
+	}
+
+	/* Share the instance with managed literals of the same value */
+	MonoString* managed = mono_string_intern(NewManagedString(str));
+	if (!managed)
+		return nullptr;
+	PinnedObjectRef ref(reinterpret_cast<MonoObject*>(managed));
+	auto it = m_strings.insert({hash, Entry_t{std::string(str), std::move(ref)}});
+	return reinterpret_cast<MonoString*>(it->second.string.Get());
+}
+
 //================================================================//
 //
 // Managed Property
 //
 //================================================================//
 
-ManagedProperty::ManagedProperty(MonoProperty& prop, ManagedClass& cls) : m_class(cls), m_property(&prop) {
-	const char* n = mono_property_get_name(m_property);
-	m_name = n;
+ManagedProperty::ManagedProperty(MonoProperty& prop, ManagedClass& cls)
+	: m_property(&prop), m_class(cls), m_name(mono_property_get_name(&prop), cls.Assembly().Arena()) {
 	m_getMethod = mono_property_get_get_method(m_property);
 	m_setMethod = mono_property_get_set_method(m_property);
 }
@@ -323,82 +1320,132 @@ ManagedProperty::~ManagedProperty() {
 //================================================================//
 
 ManagedClass::ManagedClass(ManagedAssembly* assembly, const std::string& ns, const std::string& cls)
-	: m_assembly(assembly), m_className(cls), m_namespaceName(ns), m_populated(false), m_numConstructors(0) {
+	: m_methods(assembly->Arena()), m_fields(assembly->Arena()), m_attributes(assembly->Arena()),
+	  m_attrInfo(nullptr), m_properties(assembly->Arena()), m_cacheEntry(nullptr),
+	  m_namespaceName(ns.data(), ns.size(), assembly->Arena()), m_className(cls.data(), cls.size(), assembly->Arena()),
+	  m_assembly(assembly), m_numConstructors(0), m_populatedParts(0), m_populated(false), m_boundSize(0),
+	  m_boundType(nullptr), m_vtable(nullptr) {
 	m_class = mono_class_from_name(m_assembly->m_image, ns.c_str(), cls.c_str());
 	if (!m_class) {
 		return;
 	}
-	m_attrInfo = mono_custom_attrs_from_class(m_class);
 
-	/* If there is no class name or namespace, something is fucky */
-	if (!cls.empty() && m_attrInfo) {
-		if (mono_custom_attrs_has_attr(m_attrInfo, m_class)) {
-			auto obj = mono_custom_attrs_get_attr(m_attrInfo, m_class);
-			if (!obj)
-				return;
-			m_attributes.push_back(new ManagedObject(obj, *this));
-		}
-	}
+	m_valueClass = mono_class_is_valuetype(m_class);
+	m_enumClass = mono_class_is_enum(m_class);
+	m_delegateClass = mono_class_is_delegate(m_class);
+	m_nullableClass = mono_class_is_nullable(m_class);
 
-	PopulateReflectionInfo();
+	if (!m_assembly->m_ctx->m_lazyReflection)
+		PopulateReflectionInfo();
 }
 
 ManagedClass::ManagedClass(ManagedAssembly* assembly, MonoClass* _cls, const std::string& ns, const std::string& cls)
-	: m_className(cls), m_class(_cls), m_namespaceName(ns), m_populated(false), m_assembly(assembly),
-	  m_numConstructors(0) {
-	m_attrInfo = mono_custom_attrs_from_class(m_class);
-
-	/* If there is no class name or namespace, something is fucky */
-	if (!cls.empty() && m_attrInfo) {
-		if (mono_custom_attrs_has_attr(m_attrInfo, m_class)) {
-			auto obj = mono_custom_attrs_get_attr(m_attrInfo, m_class);
-			if (!obj)
-				return;
-			m_attributes.push_back(new ManagedObject(obj, *this));
-		}
-	}
+	: m_methods(assembly->Arena()), m_fields(assembly->Arena()), m_attributes(assembly->Arena()),
+	  m_attrInfo(nullptr), m_properties(assembly->Arena()), m_cacheEntry(nullptr),
+	  m_namespaceName(ns.data(), ns.size(), assembly->Arena()), m_className(cls.data(), cls.size(), assembly->Arena()),
+	  m_class(_cls), m_assembly(assembly), m_numConstructors(0), m_populatedParts(0), m_populated(false),
+	  m_boundSize(0), m_boundType(nullptr), m_vtable(nullptr) {
+	m_valueClass = mono_class_is_valuetype(m_class);
+	m_enumClass = mono_class_is_enum(m_class);
+	m_delegateClass = mono_class_is_delegate(m_class);
+	m_nullableClass = mono_class_is_nullable(m_class);
 
-	PopulateReflectionInfo();
+	if (!m_assembly->m_ctx->m_lazyReflection)
+		PopulateReflectionInfo();
 }
 
+/* Members live in the assembly arena, so only their destructors run here */
 ManagedClass::~ManagedClass() {
 	if (m_attrInfo)
 		mono_custom_attrs_free(m_attrInfo);
+	for (auto& kv : m_cachedMethods)
+		m_assembly->Destroy(kv.second);
+	for (auto& kv : m_cachedFields)
+		m_assembly->Destroy(kv.second);
+	for (auto m : m_methods)
+		m_assembly->Destroy(m);
+	for (auto f : m_fields)
+		m_assembly->Destroy(f);
+	for (auto p : m_properties)
+		m_assembly->Destroy(p);
+	for (auto a : m_attributes)
+		m_assembly->Destroy(a);
 }
 
 void ManagedClass::PopulateReflectionInfo() {
-	ASSERT(!m_valid);
-	if (m_valid)
+	PopulateReflectionInfo(REFLECTION_ALL);
+}
+
+/* Populates the requested parts of the reflection info that haven't been populated yet */
+void ManagedClass::PopulateReflectionInfo(uint8_t parts) {
+	parts &= ~m_populatedParts;
+	if (!parts || !m_class)
 		return;
+	m_populatedParts |= parts;
 	void* iter = nullptr;
 
-	m_valueClass = mono_class_is_valuetype(m_class);
-	m_enumClass = mono_class_is_enum(m_class);
-	m_delegateClass = mono_class_is_delegate(m_class);
-	m_nullableClass = mono_class_is_nullable(m_class);
-	m_size = mono_class_instance_size(m_class);
-	m_alignment = mono_class_min_align(m_class);
+	if (parts & REFLECTION_LAYOUT) {
+		m_size = mono_class_instance_size(m_class);
+		m_alignment = mono_class_min_align(m_class);
+	}
+
+	if (parts & REFLECTION_ATTRIBUTES) {
+		m_attrInfo = mono_custom_attrs_from_class(m_class);
 
-	MonoMethod* method;
-	while ((method = mono_class_get_methods(m_class, &iter))) {
-		if (strcmp(mono_method_get_name(method), ".ctor") == 0)
-			m_numConstructors++;
-		m_methods.push_back(new ManagedMethod(method, this));
+		/* If there is no class name or namespace, something is fucky */
+		if (!m_className.empty() && m_attrInfo && mono_custom_attrs_has_attr(m_attrInfo, m_class)) {
+			auto obj = mono_custom_attrs_get_attr(m_attrInfo, m_class);
+			if (obj)
+				m_attributes.push_back(m_assembly->Allocate<ManagedObject>(obj, *this));
+		}
 	}
 
-	MonoClassField* field;
-	iter = nullptr;
-	while ((field = mono_class_get_fields(m_class, &iter))) {
-		m_fields.push_back(new ManagedField(*field, *this));
+	if (parts & REFLECTION_METHODS) {
+		MonoMethod* method;
+		iter = nullptr;
+		while ((method = mono_class_get_methods(m_class, &iter))) {
+			if (strcmp(mono_method_get_name(method), ".ctor") == 0)
+				m_numConstructors++;
+			/* Reuse anything already resolved through the reflection cache, pointers must stay stable */
+			ManagedMethod* m = nullptr;
+			auto cached = m_cachedMethods.find(mono_method_get_token(method));
+			if (cached != m_cachedMethods.end())
+				m = cached->second;
+			else
+				m = m_assembly->Allocate<ManagedMethod>(method, this);
+			m_methods.push_back(m);
+			m_methodIndex.Insert(m, m->m_name, m->m_paramCount);
+		}
+		m_cachedMethods.clear();
 	}
 
-	MonoProperty* props;
-	iter = nullptr;
-	while ((props = mono_class_get_properties(m_class, &iter))) {
-		m_properties.push_back(new ManagedProperty(*props, *this));
+	if (parts & REFLECTION_FIELDS) {
+		MonoClassField* field;
+		iter = nullptr;
+		while ((field = mono_class_get_fields(m_class, &iter))) {
+			ManagedField* f = nullptr;
+			auto cached = m_cachedFields.find(mono_class_get_field_token(field));
+			if (cached != m_cachedFields.end())
+				f = cached->second;
+			else
+				f = m_assembly->Allocate<ManagedField>(*field, *this);
+			m_fields.push_back(f);
+			m_fieldIndex.Insert(f, f->m_name);
+		}
+		m_cachedFields.clear();
 	}
 
-	m_populated = true;
+	if (parts & REFLECTION_PROPERTIES) {
+		MonoProperty* props;
+		iter = nullptr;
+		while ((props = mono_class_get_properties(m_class, &iter))) {
+			ManagedProperty* p = m_assembly->Allocate<ManagedProperty>(*props, *this);
+			m_properties.push_back(p);
+			m_propertyIndex.Insert(p, p->m_name);
+		}
+	}
+
+	m_populated = m_populatedParts == REFLECTION_ALL;
 }
 void ManagedClass::InvalidateHandle() {
 	ManagedBase<ManagedClass>::InvalidateHandle();
@@ -408,57 +1455,240 @@ void ManagedClass::InvalidateHandle() {
 	for (auto& meth : m_methods) {
 		meth->InvalidateHandle();
 	}
+	for (auto& kv : m_cachedMethods) {
+		kv.second->InvalidateHandle();
+	}
+}
+
+/* Resolves a single method by token through the reflection cache, without populating the member lists.
+ * Returns nullptr if there's no usable cache entry, or no match */
+ManagedMethod* ManagedClass::FindCachedMethod(std::string_view name, int arity, const ManagedSignatureDesc_t* sig) {
+	if (!m_cacheEntry || (m_populatedParts & REFLECTION_METHODS))
+		return nullptr;
+	ManagedMethod* found = nullptr;
+	m_assembly->m_reflectionCache.ForEachMember(
+		*m_cacheEntry, CACHE_MEMBER_METHOD, name, [&](const ReflectionCacheMember_t& entry) {
+			if (arity != ManagedMemberIndex<ManagedMethod>::AnyArity && entry.arity != arity)
+				return true;
+			if (sig && entry.signatureHash != sig->canonicalHash)
+				return true;
+
+			ManagedMethod*& method = m_cachedMethods[entry.token];
+			if (!method) {
+				MonoMethod* raw = mono_get_method(m_assembly->m_image, entry.token, m_class);
+				/* Same as FindClass, the token must resolve to a method of this name on this class */
+				if (!raw || mono_method_get_class(raw) != m_class || name != mono_method_get_name(raw)) {
+					m_cachedMethods.erase(entry.token);
+					return true;
+				}
+				method = m_assembly->Allocate<ManagedMethod>(raw, this);
+			}
+			if (sig && !method->MatchSignature(*sig))
+				return true;
+			found = method;
+			return false;
+		});
+	return found;
+}
+
+ManagedField* ManagedClass::FindCachedField(std::string_view name) {
+	if (!m_cacheEntry || (m_populatedParts & REFLECTION_FIELDS))
+		return nullptr;
+	ManagedField* found = nullptr;
+	m_assembly->m_reflectionCache.ForEachMember(
+		*m_cacheEntry, CACHE_MEMBER_FIELD, name, [&](const ReflectionCacheMember_t& entry) {
+			auto it = m_cachedFields.find(entry.token);
+			if (it != m_cachedFields.end()) {
+				found = it->second;
+				return false;
+			}
+			MonoClassField* raw = mono_class_get_field(m_class, entry.token);
+			if (!raw)
+				return true;
+			found = m_assembly->Allocate<ManagedField>(*raw, *this);
+			m_cachedFields.insert({entry.token, found});
+			return false;
+		});
+	return found;
+}
+
+ManagedMethod* ManagedClass::FindMethod(std::string_view name) {
+	if (ManagedMethod* m = FindCachedMethod(name, ManagedMemberIndex<ManagedMethod>::AnyArity, nullptr))
+		return m;
+	EnsurePopulated(REFLECTION_METHODS);
+	return m_methodIndex.Find(name);
+}
+
+ManagedMethod* ManagedClass::FindMethod(std::string_view name, int paramCount) {
+	if (ManagedMethod* m = FindCachedMethod(name, paramCount, nullptr))
+		return m;
+	EnsurePopulated(REFLECTION_METHODS);
+	return m_methodIndex.Find(name, paramCount);
+}
+
+ManagedField* ManagedClass::FindField(std::string_view name) {
+	if (ManagedField* f = FindCachedField(name))
+		return f;
+	EnsurePopulated(REFLECTION_FIELDS);
+	return m_fieldIndex.Find(name);
+}
+
+ManagedProperty* ManagedClass::FindProperty(std::string_view prop) {
+	EnsurePopulated(REFLECTION_PROPERTIES);
+	return m_propertyIndex.Find(prop);
+}
+
+size_t ManagedClass::FindOverloads(std::string_view name, std::vector<ManagedMethod*>& out) {
+	EnsurePopulated(REFLECTION_METHODS);
+	size_t count = 0;
+	m_methodIndex.ForEach(name, ManagedMemberIndex<ManagedMethod>::AnyArity, [&](ManagedMethod* m) {
+		out.push_back(m);
+		count++;
+		return true;
+	});
+	return count;
+}
+
+ManagedMethod* ManagedClass::FindMethod(std::string_view name, const ManagedSignatureDesc_t& sig) {
+	uint64_t key = HashCombine(HashString(name), sig.hash);
+	/* Only hits are cached. Verify them, another name and signature can hash to the same key */
+	auto it = m_methodSignatureCache.find(key);
+	if (it != m_methodSignatureCache.end() && it->second->m_name == name && it->second->MatchSignature(sig))
+		return it->second;
+
+	ManagedMethod* found = FindCachedMethod(name, sig.paramCount, &sig);
+	if (found) {
+		m_methodSignatureCache[key] = found;
+		return found;
+	}
+
+	EnsurePopulated(REFLECTION_METHODS);
+	m_methodIndex.ForEach(name, sig.paramCount, [&](ManagedMethod* m) {
+		if (!m->MatchSignature(sig))
+			return true;
+		found = m;
+		return false;
+	});
+	if (found)
+		m_methodSignatureCache[key] = found;
+	return found;
+}
+
+/* Creates an instance of a this class */
+ManagedObject* ManagedClass::CreateInstance(const std::vector<MonoType*>& signature, void** params) {
+	EnsurePopulated(REFLECTION_METHODS);
+	for (auto& method : m_methods) {
+		if (method->m_name == ".ctor" && method->MatchSignature(signature)) {
+			return CreateInstance(method, signature.size() > 0, params);
+		}
+	}
+
+	return nullptr;
+}
+
+ManagedObject* ManagedClass::CreateInstance(const ManagedSignatureDesc_t& sig, void** params) {
+	ManagedMethod* ctor = FindMethod(".ctor", sig);
+	if (!ctor)
+		return nullptr;
+	return CreateInstance(ctor, sig.paramCount > 0, params);
 }
 
-// TODO: Investigate perf of this, maybe use a hashmap? Might just be faster to
-// not though.
-ManagedMethod* ManagedClass::FindMethod(const std::string& name) {
-	for (auto m : m_methods) {
-		if (m->m_name == name)
-			return m;
+ManagedObject* ManagedClass::CreateInstance(ManagedMethod* ctor, bool hasParams, void** params) {
+	MonoVTable* vtable = VTable();
+	MonoObject* obj = vtable ? mono_object_new_specific(vtable) : nullptr; // Allocate storage
+	if (!obj)
+		return nullptr;
+
+	/* Only the chosen constructor runs, running the default one first would initialize the object twice */
+	MonoObject* exception = nullptr;
+	mono_runtime_invoke(ctor->m_method, obj, hasParams ? params : nullptr, &exception);
+	if (exception) {
+		m_assembly->ReportException(exception);
+		return nullptr;
 	}
-	return nullptr;
+	return new ManagedObject(obj, *this);
 }
 
-ManagedField* ManagedClass::FindField(const std::string& name) {
-	for (auto& f : m_fields) {
-		if (f->m_name == name)
-			return f;
-	}
-	return nullptr;
+MonoVTable* ManagedClass::VTable() {
+	if (!m_vtable && m_class)
+		m_vtable = mono_class_vtable(m_assembly->m_ctx->m_domain, m_class);
+	return m_vtable;
 }
 
-ManagedProperty* ManagedClass::FindProperty(const std::string& prop) {
-	for (auto& p : m_properties) {
-		if (p->m_name == prop)
-			return p;
+/* True if an instance of the value type klass holds a reference anywhere, including inside nested value types */
+static bool ValueTypeHasReferences(MonoClass* klass) {
+	void* iter = nullptr;
+	MonoClassField* field = nullptr;
+	while ((field = mono_class_get_fields(klass, &iter))) {
+		if (mono_field_get_flags(field) & MONO_FIELD_ATTR_STATIC)
+			continue;
+		MonoType* type = mono_field_get_type(field);
+		if (mono_type_is_reference(type))
+			return true;
+		if (mono_type_is_struct(type) && ValueTypeHasReferences(mono_class_from_mono_type(type)))
+			return true;
 	}
-	return nullptr;
+	return false;
 }
 
-/* Creates an instance of a this class */
-ManagedObject* ManagedClass::CreateInstance(std::vector<MonoType*> signature, void** params) {
-	for (auto& method : m_methods) {
-		if (method->m_name == ".ctor" && method->MatchSignature(signature)) {
-			MonoObject* exception = nullptr;
-			MonoObject* obj = mono_object_new(m_assembly->m_ctx->m_domain,
-											  m_class); // Allocate storage
-			mono_runtime_object_init(obj);				// Invoke default constructor
-			if (signature.size() > 0) {
-				mono_runtime_invoke(method->m_method, obj, params, &exception);
-			}
-			if (exception || !obj) {
-				m_assembly->m_ctx->ReportException(*obj, *m_assembly);
-				return nullptr;
-			}
-			return new ManagedObject(obj, *this);
+bool ManagedClass::BindStruct(size_t size, size_t alignment, const StructFieldBinding_t* fields, size_t count,
+							  const void* tag) {
+	if (!m_class || !m_valueClass || m_enumClass)
+		return false;
+
+	uint32_t managedAlign = 0;
+	int32_t managedSize = mono_class_value_size(m_class, &managedAlign);
+	if (managedSize < 0 || static_cast<size_t>(managedSize) != size || managedAlign > alignment)
+		return false;
+
+	size_t covered = 0;
+	for (auto f : Fields()) {
+		if (f->IsStatic())
+			continue;
+		MonoType* type = mono_field_get_type(&f->RawField());
+		if (mono_type_is_reference(type))
+			return false;
+		if (mono_type_is_struct(type) && ValueTypeHasReferences(mono_class_from_mono_type(type)))
+			return false;
+
+		const StructFieldBinding_t* binding = nullptr;
+		for (size_t i = 0; i < count && !binding; i++) {
+			if (f->Name() == fields[i].name)
+				binding = &fields[i];
 		}
+		if (!binding)
+			return false;
+
+		/* Field offsets of value types count the object header of the boxed form */
+		int fieldAlign = 0;
+		size_t offset = f->Offset() - sizeof(MonoObject);
+		if (binding->offset != offset || binding->size != static_cast<size_t>(mono_type_size(type, &fieldAlign)))
+			return false;
+		covered++;
 	}
+	if (covered != count)
+		return false;
 
-	return nullptr;
+	m_boundSize = static_cast<uint32_t>(size);
+	m_boundType = tag;
+	return true;
+}
+
+MonoObject* ManagedClass::BoxBlittable(const void* value, size_t size) {
+	if (!IsBlittable(size))
+		return nullptr;
+	return mono_value_box(m_assembly->m_ctx->m_domain, m_class, const_cast<void*>(value));
+}
+
+bool ManagedClass::UnboxBlittable(MonoObject* obj, void* value, size_t size) {
+	if (!obj || !IsBlittable(size) || mono_object_get_class(obj) != m_class)
+		return false;
+	memcpy(value, mono_object_unbox(obj), size);
+	return true;
 }
 
 mono_byte ManagedClass::NumConstructors() const {
+	EnsurePopulated(REFLECTION_METHODS);
 	return m_numConstructors;
 }
 
@@ -540,29 +1770,48 @@ bool ManagedClass::IsBool() {
 //
 //================================================================//
 
-ManagedObject::ManagedObject(MonoObject* obj, ManagedClass& cls, EManagedObjectHandleType type) {
-	m_obj = obj;
-	m_class = &cls;
-	switch (type) {
-	case EManagedObjectHandleType::HANDLE:
-		m_gcHandle = mono_gchandle_new(obj, false);
-		m_getObject = [this]() -> MonoObject* { return mono_gchandle_get_target(this->m_gcHandle); };
-		break;
-	case EManagedObjectHandleType::HANDLE_PINNED:
-		m_gcHandle = mono_gchandle_new(obj, true);
-		m_getObject = [this]() -> MonoObject* { return this->m_obj; };
-		break;
-	case EManagedObjectHandleType::WEAKREF:
-		m_gcHandle = mono_gchandle_new_weakref(obj, false);
-		m_getObject = [this]() -> MonoObject* { return mono_gchandle_get_target(this->m_gcHandle); };
-		break;
-	default:
-		break;
+ManagedObject::ManagedObject(MonoObject* obj, ManagedClass& cls, EManagedObjectHandleType type)
+	: m_obj(type == EManagedObjectHandleType::HANDLE_PINNED ? obj : nullptr), m_class(&cls),
+	  m_gcHandle(NewGCHandle(obj, type)), m_handleType(type) {
+}
+
+/* Copies don't inherit handles to the wrapper, only the object */
+ManagedObject::ManagedObject(const ManagedObject& other)
+	: ManagedBase<ManagedObject>(), m_obj(other.m_obj), m_class(other.m_class),
+	  m_gcHandle(NewGCHandle(const_cast<ManagedObject&>(other).RawObject(), other.m_handleType)),
+	  m_handleType(other.m_handleType) {
+}
+
+ManagedObject::ManagedObject(ManagedObject&& other) noexcept
+	: ManagedBase<ManagedObject>(), m_obj(other.m_obj), m_class(other.m_class), m_gcHandle(other.m_gcHandle),
+	  m_handleType(other.m_handleType) {
+	other.m_obj = nullptr;
+	other.m_gcHandle = 0;
+}
+
+ManagedObject& ManagedObject::operator=(const ManagedObject& other) {
+	if (this != &other)
+		*this = ManagedObject(other);
+	return *this;
+}
+
+ManagedObject& ManagedObject::operator=(ManagedObject&& other) noexcept {
+	if (this != &other) {
+		if (m_gcHandle)
+			mono_gchandle_free(m_gcHandle);
+		m_obj = other.m_obj;
+		m_class = other.m_class;
+		m_gcHandle = other.m_gcHandle;
+		m_handleType = other.m_handleType;
+		other.m_obj = nullptr;
+		other.m_gcHandle = 0;
 	}
+	return *this;
 }
 
 ManagedObject::~ManagedObject() {
-	mono_gchandle_free(m_gcHandle);
+	if (m_gcHandle)
+		mono_gchandle_free(m_gcHandle);
 }
 
 bool ManagedObject::SetProperty(ManagedProperty& prop, void* value) {
@@ -606,40 +1855,24 @@ bool ManagedObject::GetField(ManagedField& prop, void* outValue) {
 	return true;
 }
 
-bool ManagedObject::SetProperty(const std::string& p, void* value) {
-	for (auto prop : m_class->m_properties) {
-		if (p == prop->m_name) {
-			return this->SetProperty(*prop, value);
-		}
-	}
-	return false;
+bool ManagedObject::SetProperty(std::string_view p, void* value) {
+	ManagedProperty* prop = m_class->FindProperty(p);
+	return prop && this->SetProperty(*prop, value);
 }
 
-bool ManagedObject::SetField(const std::string& p, void* value) {
-	for (auto& f : m_class->m_fields) {
-		if (f->m_name == p) {
-			return this->SetField(*f, value);
-		}
-	}
-	return false;
+bool ManagedObject::SetField(std::string_view p, void* value) {
+	ManagedField* f = m_class->FindField(p);
+	return f && this->SetField(*f, value);
 }
 
-bool ManagedObject::GetProperty(const std::string& p, void** outValue) {
-	for (auto& prop : m_class->m_properties) {
-		if (prop->m_name == p) {
-			return this->GetProperty(*prop, outValue);
-		}
-	}
-	return false;
+bool ManagedObject::GetProperty(std::string_view p, void** outValue) {
+	ManagedProperty* prop = m_class->FindProperty(p);
+	return prop && this->GetProperty(*prop, outValue);
 }
 
-bool ManagedObject::GetField(const std::string& p, void* outValue) {
-	for (auto& f : m_class->m_fields) {
-		if (f->m_name == p) {
-			return this->GetField(*f, outValue);
-		}
-	}
-	return false;
+bool ManagedObject::GetField(std::string_view p, void* outValue) {
+	ManagedField* f = m_class->FindField(p);
+	return f && this->GetField(*f, outValue);
 }
 
 MonoObject* ManagedObject::Invoke(struct ManagedMethod* method, void** params) {
@@ -652,11 +1885,20 @@ MonoObject* ManagedObject::Invoke(struct ManagedMethod* method, void** params) {
 //
 //================================================================//
 
-ManagedScriptContext::ManagedScriptContext(const std::string& baseImage) : m_baseImage(baseImage) {
+ManagedScriptContext::ManagedScriptContext(const std::string& baseImage, const ManagedScriptSystemSettings_t& settings)
+	: m_baseImage(baseImage), m_lazyReflection(settings.lazyReflection),
+	  m_reflectionCacheDir(settings.reflectionCacheDir ? settings.reflectionCacheDir : "") {
+	m_describeBudget = m_exceptionPolicy.describePerSecond;
+	m_describeRefill = std::chrono::steady_clock::now();
 }
 
 ManagedScriptContext::~ManagedScriptContext() {
+	SystemClassCache_Reset();
+	DelegateInvokeCache_Reset();
+	ArrayVTableCache_Reset();
 	for (auto& a : m_loadedAssemblies) {
+		if (a->m_bundled)
+			continue;
 		if (a->m_image)
 			mono_image_close(a->m_image);
 		if (a->m_assembly)
@@ -697,18 +1939,127 @@ bool ManagedScriptContext::LoadAssembly(const char* path) {
 	if (!img) {
 		return false;
 	}
-	ManagedAssembly* newass = new ManagedAssembly(this, path, img, ass);
-	m_loadedAssemblies.push_back(newass);
-	newass->PopulateReflectionInfo();
+	AddAssembly(new ManagedAssembly(this, path, img, ass));
+	return true;
+}
+
+bool ManagedScriptContext::LoadAssemblyFromMemory(const char* name, const void* data, size_t size) {
+	ManagedAssembly* newass = LoadAssemblyFromData(name, static_cast<const char*>(data), size);
+	if (!newass)
+		return false;
+	AddAssembly(newass);
+	return true;
+}
+
+bool ManagedScriptContext::LoadAssemblyMapped(const char* path) {
+	auto file = std::make_unique<ManagedMappedFile>();
+	if (!file->Open(path))
+		return false;
+	ManagedAssembly* newass = LoadAssemblyFromData(path, file->Data(), file->Size());
+	if (!newass)
+		return false;
+	newass->m_mappedImage = std::move(file);
+	AddAssembly(newass);
+	return true;
+}
+
+bool ManagedScriptContext::LoadAssemblyFromBundle(ManagedScriptBundle& bundle, const char* name) {
+	if (!m_domain)
+		return false;
+	MonoAssembly* ass = bundle.Load(name);
+	if (!ass)
+		return false;
+	ManagedAssembly* newass = new ManagedAssembly(this, name, mono_assembly_get_image(ass), ass);
+	newass->m_bundled = true;
+	AddAssembly(newass);
 	return true;
 }
 
+/* Opens an image over data in place (need_copy = false) and loads the assembly from it */
+ManagedAssembly* ManagedScriptContext::LoadAssemblyFromData(const char* name, const char* data, size_t size) {
+	if (!m_domain || !data || size > UINT32_MAX)
+		return nullptr;
+
+	MonoImageOpenStatus status = MONO_IMAGE_OK;
+	MonoImage* img = mono_image_open_from_data_with_name(const_cast<char*>(data), static_cast<uint32_t>(size), false,
+														 &status, false, name);
+	if (!img || status != MONO_IMAGE_OK)
+		return nullptr;
+
+	MonoAssembly* ass = mono_assembly_load_from_full(img, name, &status, false);
+	if (!ass || status != MONO_IMAGE_OK) {
+		mono_image_close(img);
+		return nullptr;
+	}
+	return new ManagedAssembly(this, name, img, ass);
+}
+
+size_t ManagedScriptContext::LoadAssemblies(const std::vector<std::string>& paths, unsigned int threads) {
+	if (!m_domain || paths.empty())
+		return 0;
+	if (!threads)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	threads = std::min<size_t>(threads, paths.size());
+
+	/* Workers only touch their own assemblies. Nothing is visible to the context until all of them are done */
+	std::vector<ManagedAssembly*> loaded(paths.size(), nullptr);
+	std::atomic<size_t> next{0};
+	auto worker = [&]() {
+		MonoThread* thread = mono_thread_attach(m_domain);
+		for (size_t i = next++; i < paths.size(); i = next++) {
+			MonoAssembly* ass = mono_domain_assembly_open(m_domain, paths[i].c_str());
+			MonoImage* img = ass ? mono_assembly_get_image(ass) : nullptr;
+			if (!img)
+				continue;
+			loaded[i] = new ManagedAssembly(this, paths[i], img, ass);
+			loaded[i]->PopulateReflectionInfo(true);
+		}
+		mono_thread_detach(thread);
+	};
+
+	std::vector<std::thread> pool;
+	for (unsigned int i = 0; i < threads; i++)
+		pool.emplace_back(worker);
+	for (auto& t : pool)
+		t.join();
+
+	/* Publish in the order they were passed in, so the class search order matches sequential loads */
+	size_t count = 0;
+	for (auto assembly : loaded) {
+		if (!assembly)
+			continue;
+		m_loadedAssemblies.push_back(assembly);
+		count++;
+	}
+	if (count)
+		InvalidateTypeIndex(nullptr);
+	return count;
+}
+
+void ManagedScriptContext::AddAssembly(ManagedAssembly* assembly) {
+	m_loadedAssemblies.push_back(assembly);
+	/* New assemblies go to the back of the search order, so only misses can become stale */
+	InvalidateTypeIndex(nullptr);
+	assembly->PopulateReflectionInfo();
+}
+
 bool ManagedScriptContext::UnloadAssembly(const std::string& name) {
 	for (auto it = m_loadedAssemblies.begin(); it != m_loadedAssemblies.end(); ++it) {
 		if ((*it)->m_path == name) {
-			if ((*it)->m_image)
+			/* Invalidates the handles and releases the reflection arena */
+			(*it)->Unload();
+			/* System class lookups walk every assembly, so cached hits may point into this one */
+			SystemClassCache_Reset();
+			/* Keyed by MonoClass*, which may be reused once the image is closed */
+			{
+				std::lock_guard<std::mutex> lock(m_exceptionMutex);
+				m_exceptionClasses.clear();
+			}
+			DelegateInvokeCache_Reset();
+			ArrayVTableCache_Reset();
+			if ((*it)->m_image && !(*it)->m_bundled)
 				mono_image_close((*it)->m_image);
-			if ((*it)->m_assembly)
+			if ((*it)->m_assembly && !(*it)->m_bundled)
 				mono_assembly_close((*it)->m_assembly);
 			m_loadedAssemblies.erase(it);
 			return true;
@@ -721,45 +2072,79 @@ bool ManagedScriptContext::UnloadAssembly(const std::string& name) {
 /* If you have the assembly name, please use the alternative version of this
  * function */
 ManagedClass* ManagedScriptContext::FindClass(const std::string& ns, const std::string& cls) {
+	uint64_t hash = HashTypeName(ns, cls);
+
+	auto hit = m_typeIndex.find(hash);
+	if (hit != m_typeIndex.end() && std::string_view(hit->second->m_namespaceName) == ns &&
+		std::string_view(hit->second->m_className) == cls)
+		return hit->second;
+
+	auto miss = m_missedTypes.find(hash);
+	if (miss != m_missedTypes.end() && miss->second.ns == ns && miss->second.cls == cls)
+		return nullptr;
+
 	/* Try to find the managed class in each of the assemblies. if found, create
 	 * the managed class and return */
-	/* Also check the hashmap we have setup */
 	for (auto& a : m_loadedAssemblies) {
 		ManagedClass* _cls = nullptr;
-		if (a && (_cls = FindClass(*a, ns, cls)))
+		if (a && (_cls = FindClass(*a, ns, cls))) {
+			m_typeIndex[hash] = _cls;
 			return _cls;
+		}
 	}
+
+	m_missedTypes[hash] = {ns, cls};
 	return nullptr;
 }
 
 ManagedClass* ManagedScriptContext::FindClass(ManagedAssembly& assembly, const std::string& ns,
 											  const std::string& cls) {
-	auto itpair = assembly.m_classes.equal_range(ns);
+	uint64_t hash = HashTypeName(ns, cls);
+	auto itpair = assembly.m_classes.equal_range(hash);
 	for (auto it = itpair.first; it != itpair.second; ++it) {
-		if (it->second->m_className == cls)
+		if (std::string_view(it->second->m_namespaceName) == ns && std::string_view(it->second->m_className) == cls)
 			return it->second;
 	}
 
-	/* Have mono perform the class lookup. If it's there, create and add a new
-	 * managed class */
-	MonoClass* monoClass = mono_class_from_name(assembly.m_image, ns.c_str(), cls.c_str());
+	/* Resolve by token if the reflection cache knows the type, otherwise have mono perform
+	 * the class lookup. If it's there, create and add a new managed class */
+	const ReflectionCacheType_t* cacheEntry = assembly.m_reflectionCache.FindType(ns, cls);
+	MonoClass* monoClass = cacheEntry ? mono_class_get(assembly.m_image, cacheEntry->token) : nullptr;
+	/* Only the GUID ties the cache to the image, so make sure the token really names ns.cls */
+	if (monoClass && (ns != mono_class_get_namespace(monoClass) || cls != mono_class_get_name(monoClass)))
+		monoClass = nullptr;
+	/* The entry's member tokens are no better than its own, leave the class to full population */
+	if (!monoClass) {
+		cacheEntry = nullptr;
+		monoClass = mono_class_from_name(assembly.m_image, ns.c_str(), cls.c_str());
+	}
 	if (monoClass) {
-		ManagedClass* _class = new ManagedClass(&assembly, monoClass, ns, cls);
-		assembly.m_classes.insert({ns, _class});
+		ManagedClass* _class = assembly.Allocate<ManagedClass>(&assembly, monoClass, ns, cls);
+		_class->m_cacheEntry = cacheEntry;
+		assembly.m_classes.insert({hash, _class});
 		return _class;
 	}
 
 	return nullptr;
 }
 
-/* Used to locate a class not added by any assemblies explicitly loaded by the
- * user */
-/* These assemblies are usually going to be system assemblies or members of the
- * C# standard library */
-MonoClass* ManagedScriptContext::FindSystemClass(const std::string& ns, const std::string& cls) {
+/* Drops cached misses, and any cached hits that point into assembly */
+void ManagedScriptContext::InvalidateTypeIndex(ManagedAssembly* assembly) {
+	m_missedTypes.clear();
+	if (!assembly)
+		return;
+	for (auto it = m_typeIndex.begin(); it != m_typeIndex.end();) {
+		if (it->second->m_assembly == assembly)
+			it = m_typeIndex.erase(it);
+		else
+			++it;
+	}
+}
+
+/* Walks every assembly in the process looking for ns.cls */
+static MonoClass* LookupSystemClass(const std::string& ns, const std::string& cls) {
 	struct pvt_t
 	{
-		ManagedScriptContext* _this;
 		const char* ns;
 		const char* cls;
 		bool isdone;
@@ -768,7 +2153,6 @@ MonoClass* ManagedScriptContext::FindSystemClass(const std::string& ns, const st
 
 	pvt.cls = cls.c_str();
 	pvt.ns = ns.c_str();
-	pvt._this = this;
 	pvt.result = nullptr;
 	pvt.isdone = false;
 
@@ -796,6 +2180,69 @@ MonoClass* ManagedScriptContext::FindSystemClass(const std::string& ns, const st
 	return pvt.result;
 }
 
+static void SystemClassCache_AssemblyLoaded(MonoAssembly* assembly, void* userData) {
+	/* Any cached miss might resolve now. Hooks can fire on any thread, so only bump the generation here */
+	g_assemblyLoadGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void SystemClassCache_Reset() {
+	static const char* const seedTypes[][2] = {
+		{"System", "Array"},
+		{"System", "Type"},
+		{"System", "Delegate"},
+		{"System", "MulticastDelegate"},
+		{"System", "ValueType"},
+		{"System.Collections", "IEnumerable"},
+		{"System.Collections.Generic", "List`1"},
+		{"System.Collections.Generic", "Dictionary`2"},
+		{"System.Collections.Generic", "HashSet`1"},
+		{"System.Collections.Generic", "IEnumerable`1"},
+		{"System.Collections.Generic", "IList`1"},
+		{"System.Collections.Generic", "IDictionary`2"},
+		{"System.Collections.Generic", "KeyValuePair`2"},
+	};
+
+	auto seed = [](const char* ns, const char* cls, MonoClass* klass) {
+		if (klass)
+			g_systemClasses[HashTypeName(ns, cls)] = {ns, cls, klass, 0};
+	};
+
+	std::lock_guard<std::mutex> lock(g_systemClassMutex);
+	g_systemClasses.clear();
+	seed("System", "Object", mono_get_object_class());
+	seed("System", "String", mono_get_string_class());
+	seed("System", "Exception", mono_get_exception_class());
+	seed("System", "Enum", mono_get_enum_class());
+
+	MonoImage* corlib = mono_get_corlib();
+	for (auto& type : seedTypes) {
+		seed(type[0], type[1], corlib ? mono_class_from_name(corlib, type[0], type[1]) : nullptr);
+	}
+}
+
+/* Used to locate a class not added by any assemblies explicitly loaded by the
+ * user */
+/* These assemblies are usually going to be system assemblies or members of the
+ * C# standard library */
+MonoClass* ManagedScriptContext::FindSystemClass(const std::string& ns, const std::string& cls) {
+	uint64_t hash = HashTypeName(ns, cls);
+	uint32_t generation = g_assemblyLoadGeneration.load(std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(g_systemClassMutex);
+		auto it = g_systemClasses.find(hash);
+		if (it != g_systemClasses.end() && it->second.ns == ns && it->second.cls == cls &&
+			(it->second.klass || it->second.generation == generation))
+			return it->second.klass;
+	}
+
+	/* Not under the lock, walking the assemblies takes mono's loader lock */
+	MonoClass* result = LookupSystemClass(ns, cls);
+	std::lock_guard<std::mutex> lock(g_systemClassMutex);
+	g_systemClasses[hash] = {ns, cls, result, generation};
+	return result;
+}
+
 ManagedAssembly* ManagedScriptContext::FindAssembly(const std::string& path) {
 	for (auto& a : m_loadedAssemblies) {
 		if (a->m_path == path) {
@@ -808,11 +2255,14 @@ ManagedAssembly* ManagedScriptContext::FindAssembly(const std::string& path) {
 /* Clears all reflection info stored in each assembly description */
 /* WARNING: this will invalidate your handles! */
 void ManagedScriptContext::ClearReflectionInfo() {
+	m_typeIndex.clear();
+	m_missedTypes.clear();
+	{
+		std::lock_guard<std::mutex> lock(m_exceptionMutex);
+		m_exceptionClasses.clear();
+	}
 	for (auto& a : m_loadedAssemblies) {
-		for (auto& kvPair : a->m_classes) {
-			delete kvPair.second;
-		}
-		a->m_classes.clear();
+		a->DisposeReflectionInfo();
 	}
 }
 
@@ -831,71 +2281,453 @@ bool ManagedScriptContext::ValidateAgainstWhitelist(const std::vector<std::strin
 }
 
 void ManagedScriptContext::ReportException(MonoObject& obj, ManagedAssembly& ass) {
-	auto exc = this->GetExceptionDescriptor(&obj);
+	ManagedExceptionView view(*this, &obj);
+	uint64_t fingerprint = view.Fingerprint();
+
+	/* Only the bookkeeping is locked, callbacks and the queue push run outside */
+	uint64_t count, suppressed;
+	{
+		std::lock_guard<std::mutex> lock(m_exceptionMutex);
+		auto& fp = m_exceptionFingerprints[fingerprint];
+		if (!fp.count) {
+			MonoClass* klass = mono_object_get_class(&obj);
+			fp.klass = mono_class_get_name(klass);
+			fp.ns = mono_class_get_namespace(klass);
+		}
+		fp.count++;
 
+		/* Past its budget a repeated exception is only counted */
+		if (!ShouldDescribe(fp)) {
+			fp.suppressed++;
+			return;
+		}
+		fp.described++;
+		count = fp.count;
+		suppressed = fp.suppressed;
+		fp.suppressed = 0;
+	}
+
+	for (auto& c : m_viewCallbacks) {
+		c(this, &ass, view);
+	}
+
+	if (m_callbacks.empty() && !m_reporter)
+		return;
+	auto exc = view.Descriptor();
 	for (auto& c : m_callbacks) {
 		c(this, &ass, &obj, exc);
 	}
+
+	if (m_reporter) {
+		ManagedExceptionReport_t report;
+		report.exception = std::move(exc);
+		report.assembly = ass.m_path;
+		report.fingerprint = fingerprint;
+		report.count = count;
+		report.suppressed = suppressed;
+		m_reporter->Post(std::move(report));
+	}
+}
+
+bool ManagedScriptContext::ShouldDescribe(ExceptionFingerprint_t& fingerprint) {
+	if (!m_exceptionPolicy.throttle || fingerprint.described < m_exceptionPolicy.describeFirst)
+		return true;
+
+	/* Refill the shared budget, capped at one second's worth */
+	auto now = std::chrono::steady_clock::now();
+	float elapsed = std::chrono::duration<float>(now - m_describeRefill).count();
+	m_describeRefill = now;
+	m_describeBudget = std::min(m_describeBudget + elapsed * m_exceptionPolicy.describePerSecond,
+								m_exceptionPolicy.describePerSecond);
+	if (m_describeBudget < 1.0f)
+		return false;
+	m_describeBudget -= 1.0f;
+	return true;
+}
+
+void ManagedScriptContext::SetExceptionPolicy(const ManagedExceptionPolicy_t& policy) {
+	std::lock_guard<std::mutex> lock(m_exceptionMutex);
+	m_exceptionPolicy = policy;
+	m_describeBudget = policy.describePerSecond;
+	m_describeRefill = std::chrono::steady_clock::now();
+}
+
+void ManagedScriptContext::RegisterExceptionReportCallback(ManagedExceptionReporter::CallbackT callback) {
+	if (!m_reporter)
+		m_reporter = std::make_unique<ManagedExceptionReporter>(m_exceptionPolicy.queueCapacity);
+	m_reporter->AddCallback(std::move(callback));
+}
+
+std::vector<ManagedExceptionStats_t> ManagedScriptContext::ExceptionStats() const {
+	std::lock_guard<std::mutex> lock(m_exceptionMutex);
+	std::vector<ManagedExceptionStats_t> stats;
+	stats.reserve(m_exceptionFingerprints.size());
+	for (auto& [fingerprint, fp] : m_exceptionFingerprints) {
+		stats.push_back({fingerprint, fp.klass, fp.ns, fp.count, fp.described});
+	}
+	return stats;
 }
 
 ManagedException_t ManagedScriptContext::GetExceptionDescriptor(MonoObject* exception) {
-	ManagedException_t exc;
+	ManagedExceptionView view(*this, exception);
+	return view.Descriptor();
+}
+
+ManagedExceptionClassInfo_t ManagedScriptContext::ExceptionClassInfo(MonoClass* cls) {
+	std::lock_guard<std::mutex> lock(m_exceptionMutex);
+	auto it = m_exceptionClasses.find(cls);
+	if (it != m_exceptionClasses.end())
+		return it->second;
 
 	/* Make sure that the baseclass of the exception is System.Exception. If
 	 * not, we've got some weird object that we shouldn't have */
-	MonoClass* cls = mono_object_get_class(exception);
+	ManagedExceptionClassInfo_t info = {};
 	MonoClass* excClass = FindSystemClass("System", "Exception");
-	if (!mono_object_isinst(exception, excClass)) {
-		return exc;
+	info.isException = excClass && mono_class_is_subclass_of(cls, excClass, false);
+	if (info.isException) {
+		auto getter = [cls](const char* name) -> MonoMethod* {
+			MonoProperty* prop = mono_class_get_property_from_name(cls, name);
+			return prop ? mono_property_get_get_method(prop) : nullptr;
+		};
+		info.getMessage = getter("Message");
+		info.getSource = getter("Source");
+		info.getStackTrace = getter("StackTrace");
+
+		/* Mono keeps the raw frame IPs in a private field, named differently across runtimes */
+		for (const char* name : {"_traceIPs", "trace_ips"}) {
+			if ((info.traceIps = mono_class_get_field_from_name(excClass, name)))
+				break;
+		}
 	}
+	return m_exceptionClasses.insert({cls, info}).first->second;
+}
+
+//================================================================//
+//
+// Managed Update Registry
+//
+//================================================================//
 
-	/* Obtain the properties by iterating through the class's props */
-	MonoProperty* propMsg = mono_class_get_property_from_name(cls, "Message");
-	MonoProperty* propSrc = mono_class_get_property_from_name(cls, "Source");
-	MonoProperty* propST = mono_class_get_property_from_name(cls, "StackTrace");
+ManagedUpdateRegistry::ManagedUpdateRegistry(std::string methodName, bool pinned)
+	: m_methodName(std::move(methodName)), m_pinned(pinned), m_runDepth(0), m_size(0) {
+}
+
+ManagedUpdateRegistry::~ManagedUpdateRegistry() {
+	Clear();
+}
+
+ManagedUpdateRegistry::EntryId ManagedUpdateRegistry::Add(ManagedObject& obj, int32_t priority) {
+	return Add(obj.RawObject(), *obj.m_class, priority);
+}
 
-	/* Obtain the properties */
-	/* This is a big weird and unoptimized because mono I guess */
-	MonoObject* msg = nullptr;
-	MonoObject* src = nullptr;
-	MonoObject* stack = nullptr;
-	MonoObject* propexcept = nullptr;
-	msg = mono_property_get_value(propMsg, exception, nullptr, &propexcept);
-	src = mono_property_get_value(propSrc, exception, nullptr, &propexcept);
-	stack = mono_property_get_value(propST, exception, nullptr, &propexcept);
+ManagedUpdateRegistry::EntryId ManagedUpdateRegistry::Add(MonoObject* obj, ManagedClass& cls, int32_t priority) {
+	if (!obj)
+		return InvalidEntry;
+	ManagedMethod* method = cls.FindMethod<void()>(m_methodName);
+	if (!method || !method->IsInstance())
+		return InvalidEntry;
+	ThunkT thunk = reinterpret_cast<ThunkT>(method->UnmanagedThunk());
+	if (!thunk)
+		return InvalidEntry;
 
-	if (msg) {
-		char* buf = mono_string_to_utf8(mono_object_to_string(msg, nullptr));
-		exc.message = (const char*)buf;
-		mono_free(buf);
+	EntryId id;
+	if (!m_freeIds.empty()) {
+		id = m_freeIds.back();
+		m_freeIds.pop_back();
+	}
+	else {
+		m_locations.push_back({nullptr, 0});
+		id = static_cast<EntryId>(m_locations.size());
 	}
-	if (src) {
-		char* buf = mono_string_to_utf8(mono_object_to_string(src, nullptr));
-		exc.source = (const char*)buf;
-		mono_free(buf);
+
+	Bucket_t& bucket = m_buckets[priority];
+	m_locations[id - 1] = {&bucket, static_cast<uint32_t>(bucket.ids.size())};
+	bucket.handles.push_back(NewGCHandle(obj, m_pinned ? EManagedObjectHandleType::HANDLE_PINNED
+													  : EManagedObjectHandleType::HANDLE));
+	bucket.objects.push_back(m_pinned ? obj : nullptr);
+	bucket.thunks.push_back(thunk);
+	bucket.enabled.push_back(1);
+	bucket.ids.push_back(id);
+	bucket.methods.push_back(method);
+	m_size++;
+	return id;
+}
+
+bool ManagedUpdateRegistry::Remove(EntryId id) {
+	if (id == InvalidEntry || id > m_locations.size() || !m_locations[id - 1].bucket)
+		return false;
+
+	/* Erasing would move entries under the running loop, so it waits until the frame is done */
+	if (m_runDepth) {
+		Location_t& loc = m_locations[id - 1];
+		loc.bucket->enabled[loc.slot] = 0;
+		if (std::find(m_pendingRemovals.begin(), m_pendingRemovals.end(), id) == m_pendingRemovals.end())
+			m_pendingRemovals.push_back(id);
+		return true;
 	}
-	if (stack) {
-		char* buf = mono_string_to_utf8(mono_object_to_string(stack, nullptr));
-		exc.stackTrace = (const char*)buf;
-		mono_free(buf);
+	Erase(id);
+	return true;
+}
+
+void ManagedUpdateRegistry::Erase(EntryId id) {
+	Location_t loc = m_locations[id - 1];
+	Bucket_t& b = *loc.bucket;
+	size_t last = b.ids.size() - 1;
+
+	mono_gchandle_free(b.handles[loc.slot]);
+	if (loc.slot != last) {
+		b.handles[loc.slot] = b.handles[last];
+		b.objects[loc.slot] = b.objects[last];
+		b.thunks[loc.slot] = b.thunks[last];
+		b.enabled[loc.slot] = b.enabled[last];
+		b.ids[loc.slot] = b.ids[last];
+		b.methods[loc.slot] = b.methods[last];
+		m_locations[b.ids[loc.slot] - 1].slot = loc.slot;
 	}
+	b.handles.pop_back();
+	b.objects.pop_back();
+	b.thunks.pop_back();
+	b.enabled.pop_back();
+	b.ids.pop_back();
+	b.methods.pop_back();
+
+	m_locations[id - 1] = {nullptr, 0};
+	m_freeIds.push_back(id);
+	m_size--;
+}
+
+bool ManagedUpdateRegistry::SetEnabled(EntryId id, bool enabled) {
+	if (id == InvalidEntry || id > m_locations.size() || !m_locations[id - 1].bucket)
+		return false;
+	/* Removed during this Run(), it must not come back before it's erased */
+	if (std::find(m_pendingRemovals.begin(), m_pendingRemovals.end(), id) != m_pendingRemovals.end())
+		return false;
+	Location_t& loc = m_locations[id - 1];
+	loc.bucket->enabled[loc.slot] = enabled;
+	return true;
+}
+
+bool ManagedUpdateRegistry::Enabled(EntryId id) const {
+	if (id == InvalidEntry || id > m_locations.size() || !m_locations[id - 1].bucket)
+		return false;
+	const Location_t& loc = m_locations[id - 1];
+	return loc.bucket->enabled[loc.slot];
+}
 
-	exc.klass = mono_class_get_name(cls);
-	exc.ns = mono_class_get_namespace(cls);
+void ManagedUpdateRegistry::Clear() {
+	ASSERT(!m_runDepth);
+	for (auto& [priority, bucket] : m_buckets) {
+		for (auto handle : bucket.handles)
+			mono_gchandle_free(handle);
+	}
+	m_buckets.clear();
+	m_locations.clear();
+	m_freeIds.clear();
+	m_pendingRemovals.clear();
+	m_size = 0;
+}
+
+ManagedBatchResult_t ManagedUpdateRegistry::Run(EBatchExceptionPolicy policy) {
+	ManagedBatchResult_t result;
+	m_runDepth++;
+	bool stop = false;
+	for (auto it = m_buckets.begin(); it != m_buckets.end() && !stop; ++it) {
+		Bucket_t& b = it->second;
+		/* Re-read the size, entries added by the callees run this frame too */
+		for (size_t i = 0; i < b.ids.size(); i++) {
+			if (!b.enabled[i])
+				continue;
+			MonoObject* obj = m_pinned ? b.objects[i] : mono_gchandle_get_target(b.handles[i]);
+			if (!obj) {
+				result.nullObjects++;
+				continue;
+			}
 
-	MonoObject* pexc = nullptr;
-	char* str = mono_string_to_utf8(mono_object_to_string(exception, &pexc));
+			MonoException* exc = nullptr;
+			b.thunks[i](obj, &exc);
+			result.invoked++;
+			if (!exc)
+				continue;
+
+			result.failed++;
+			MonoObject* excObj = reinterpret_cast<MonoObject*>(exc);
+			if (policy == EBatchExceptionPolicy::COLLECT)
+				result.exceptions.push_back({b.ids[i], StrongObjectRef(excObj)});
+			else if (result.failed == 1)
+				b.methods[i]->ReportException(excObj);
+			if (policy == EBatchExceptionPolicy::STOP) {
+				stop = true;
+				break;
+			}
+		}
+	}
+	/* An outer frame may still be looping over the buckets */
+	if (--m_runDepth)
+		return result;
 
-	if (!pexc && str) {
-		exc.string_rep = (const char*)str;
+	for (EntryId id : m_pendingRemovals) {
+		if (m_locations[id - 1].bucket)
+			Erase(id);
 	}
+	m_pendingRemovals.clear();
+	return result;
+}
+
+//================================================================//
+//
+// Managed Exception View
+//
+//================================================================//
+
+ManagedExceptionView::ManagedExceptionView(ManagedScriptContext& ctx, MonoObject* exception)
+	: m_exception(exception), m_class(mono_object_get_class(exception)), m_info(ctx.ExceptionClassInfo(m_class)),
+	  m_resolved(0) {
+}
+
+const char* ManagedExceptionView::ClassName() const {
+	return mono_class_get_name(m_class);
+}
+
+const char* ManagedExceptionView::Namespace() const {
+	return mono_class_get_namespace(m_class);
+}
+
+const std::string& ManagedExceptionView::Resolve(EField field, MonoMethod* getter, std::string& out) {
+	if (m_resolved & field)
+		return out;
+	m_resolved |= field;
+	if (!getter)
+		return out;
+
+	/* The properties are strings already, so they're transcoded straight out of the managed buffers */
+	MonoObject* exc = nullptr;
+	MonoObject* value = mono_runtime_invoke(getter, m_exception, nullptr, &exc);
+	if (value && !exc)
+		out = ToUtf8(reinterpret_cast<MonoString*>(value));
+	return out;
+}
+
+const std::string& ManagedExceptionView::Message() {
+	return Resolve(FIELD_MESSAGE, m_info.getMessage, m_message);
+}
+
+const std::string& ManagedExceptionView::Source() {
+	return Resolve(FIELD_SOURCE, m_info.getSource, m_source);
+}
+
+const std::string& ManagedExceptionView::StackTrace() {
+	return Resolve(FIELD_STACKTRACE, m_info.getStackTrace, m_stackTrace);
+}
 
-	if (str)
-		mono_free(str);
+const std::string& ManagedExceptionView::ToString() {
+	if (m_resolved & FIELD_STRING)
+		return m_string;
+	m_resolved |= FIELD_STRING;
+	MonoObject* exc = nullptr;
+	MonoString* str = mono_object_to_string(m_exception, &exc);
+	if (!exc && str)
+		m_string = ToUtf8(str);
+	return m_string;
+}
+
+uintptr_t ManagedExceptionView::ThrowSite() const {
+	if (!m_info.traceIps)
+		return 0;
+	MonoObject* ips = nullptr;
+	mono_field_get_value(m_exception, m_info.traceIps, &ips);
+	if (!ips || mono_class_get_rank(mono_object_get_class(ips)) != 1)
+		return 0;
+	MonoArray* arr = reinterpret_cast<MonoArray*>(ips);
+	if (mono_array_length(arr) == 0 || mono_array_element_size(mono_object_get_class(ips)) != sizeof(uintptr_t))
+		return 0;
+	/* The first entry is the throwing frame */
+	return mono_array_get(arr, uintptr_t, 0);
+}
 
+ManagedException_t ManagedExceptionView::Descriptor() {
+	ManagedException_t exc;
+	if (!IsException())
+		return exc;
+	exc.message = Message();
+	exc.source = Source();
+	exc.stackTrace = StackTrace();
+	exc.klass = ClassName();
+	exc.ns = Namespace();
+	exc.string_rep = ToString();
 	return exc;
 }
 
+//================================================================//
+//
+// Managed Exception Reporter
+//
+//================================================================//
+
+ManagedExceptionReporter::ManagedExceptionReporter(size_t capacity)
+	: m_queue(capacity), m_stop(false), m_posted(0), m_delivered(0), m_dropped(0) {
+	m_thread = std::thread(&ManagedExceptionReporter::Run, this);
+}
+
+ManagedExceptionReporter::~ManagedExceptionReporter() {
+	m_stop.store(true);
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+	}
+	m_wake.notify_one();
+	m_thread.join();
+}
+
+void ManagedExceptionReporter::AddCallback(CallbackT callback) {
+	std::lock_guard<std::mutex> lock(m_callbackMutex);
+	m_callbacks.push_back(std::move(callback));
+}
+
+bool ManagedExceptionReporter::Post(ManagedExceptionReport_t&& report) {
+	if (!m_queue.TryPush(std::move(report))) {
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	m_posted.fetch_add(1, std::memory_order_release);
+	/* Not taking m_wakeMutex can lose a wakeup, the reporter thread also wakes up on a timeout */
+	m_wake.notify_one();
+	return true;
+}
+
+void ManagedExceptionReporter::Flush() {
+	uint64_t target = m_posted.load(std::memory_order_acquire);
+	std::unique_lock<std::mutex> lock(m_wakeMutex);
+	m_wake.notify_one();
+	m_idle.wait(lock, [&] { return m_delivered.load(std::memory_order_acquire) >= target; });
+}
+
+void ManagedExceptionReporter::Deliver() {
+	ManagedExceptionReport_t report;
+	while (m_queue.TryPop(report)) {
+		{
+			std::lock_guard<std::mutex> lock(m_callbackMutex);
+			for (auto& c : m_callbacks)
+				c(report);
+		}
+		m_delivered.fetch_add(1, std::memory_order_release);
+	}
+}
+
+void ManagedExceptionReporter::Run() {
+	for (;;) {
+		Deliver();
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_idle.notify_all();
+		if (m_stop.load())
+			break;
+		m_wake.wait_for(lock, std::chrono::milliseconds(50), [&] {
+			uint64_t posted = m_posted.load(std::memory_order_acquire);
+			return m_stop.load() || m_delivered.load(std::memory_order_relaxed) != posted;
+		});
+	}
+	/* Anything posted while stopping */
+	Deliver();
+}
+
 //================================================================//
 //
 // Managed Script System
@@ -954,6 +2786,40 @@ ManagedScriptSystem::ManagedScriptSystem(ManagedScriptSystemSettings_t settings)
 		ASSERT(0);
 		abort();
 	}
+
+	mono_install_assembly_load_hook(SystemClassCache_AssemblyLoaded, nullptr);
+	mono_install_assembly_preload_hook(BundlePreloadHook, this);
+	SystemClassCache_Reset();
+}
+
+ManagedScriptBundle* ManagedScriptSystem::LoadBundle(const char* path) {
+	auto bundle = std::make_unique<ManagedScriptBundle>();
+	if (!bundle->Open(path))
+		return nullptr;
+	std::lock_guard<std::mutex> lock(m_bundleMutex);
+	m_bundles.push_back(std::move(bundle));
+	return m_bundles.back().get();
+}
+
+/* Resolves assembly references out of the registered bundles, in registration order */
+MonoAssembly* ManagedScriptSystem::BundlePreloadHook(MonoAssemblyName* aname, char** assembliesPath, void* userData) {
+	auto system = static_cast<ManagedScriptSystem*>(userData);
+	const char* name = mono_assembly_name_get_name(aname);
+	if (!name)
+		return nullptr;
+
+	/* Don't hold the lock while loading, that can come back through here for references */
+	std::vector<ManagedScriptBundle*> bundles;
+	{
+		std::lock_guard<std::mutex> lock(system->m_bundleMutex);
+		for (auto& bundle : system->m_bundles)
+			bundles.push_back(bundle.get());
+	}
+	for (auto bundle : bundles) {
+		if (MonoAssembly* ass = bundle->Load(name))
+			return ass;
+	}
+	return nullptr;
 }
 
 ManagedScriptSystem::~ManagedScriptSystem() {
@@ -964,7 +2830,19 @@ ManagedScriptSystem::~ManagedScriptSystem() {
 }
 
 ManagedScriptContext* ManagedScriptSystem::CreateContext(const char* image) {
-	ManagedScriptContext* ctx = new ManagedScriptContext(image);
+	return CreateContext(image, m_settings.lazyReflection);
+}
+
+ManagedScriptContext* ManagedScriptSystem::CreateContext(const char* image, bool lazyReflection) {
+	return CreateContext(image, lazyReflection, m_settings.reflectionCacheDir);
+}
+
+ManagedScriptContext* ManagedScriptSystem::CreateContext(const char* image, bool lazyReflection,
+														 const char* reflectionCacheDir) {
+	ManagedScriptSystemSettings_t settings = m_settings;
+	settings.lazyReflection = lazyReflection;
+	settings.reflectionCacheDir = reflectionCacheDir;
+	ManagedScriptContext* ctx = new ManagedScriptContext(image, settings);
 
 	if (!ctx->Init()) {
 		delete ctx;
@@ -1,13 +1,25 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
 #include <functional>
+#include <initializer_list>
 #include <list>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <stack>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -22,6 +34,68 @@
 
 namespace mono {
 
+//==============================================================================================//
+// Hashing helpers
+//==============================================================================================//
+
+/* FNV-1a, usable at compile time */
+constexpr uint64_t HashBytes(const char* data, size_t len, uint64_t hash = 0xcbf29ce484222325ULL) {
+	for (size_t i = 0; i < len; i++) {
+		hash ^= static_cast<uint8_t>(data[i]);
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+constexpr uint64_t HashString(std::string_view str, uint64_t hash = 0xcbf29ce484222325ULL) {
+	return HashBytes(str.data(), str.size(), hash);
+}
+
+constexpr uint64_t HashCombine(uint64_t hash, uint64_t value) {
+	for (int i = 0; i < 8; i++) {
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+/* Hash of a fully qualified type name, used to key class lookups */
+constexpr uint64_t HashTypeName(std::string_view ns, std::string_view cls) {
+	return HashCombine(HashString(ns), HashString(cls));
+}
+
+//==============================================================================================//
+// ManagedRange
+//	Read-only view over a reflection member list; keeps the backing storage out of the API
+//==============================================================================================//
+template <class T> class ManagedRange
+{
+private:
+	T* const* m_begin;
+	size_t m_size;
+
+public:
+	ManagedRange(T* const* begin, size_t size) : m_begin(begin), m_size(size) {}
+
+	template <class C> ManagedRange(const C& container) : m_begin(container.data()), m_size(container.size()) {}
+
+	T* const* begin() const {
+		return m_begin;
+	}
+	T* const* end() const {
+		return m_begin + m_size;
+	}
+	size_t size() const {
+		return m_size;
+	}
+	bool empty() const {
+		return m_size == 0;
+	}
+	T* operator[](size_t i) const {
+		return m_begin[i];
+	}
+};
+
 template <class T> class ManagedBase;
 
 template <class T> class ManagedHandle
@@ -120,6 +194,220 @@ protected:
 	}
 };
 
+//==============================================================================================//
+// ManagedMappedFile
+//      Read-only memory mapping of a whole file
+//==============================================================================================//
+class ManagedMappedFile
+{
+private:
+	const char* m_data;
+	size_t m_size;
+	void* m_mapping; // Mapping handle, only used on windows
+
+public:
+	ManagedMappedFile();
+	~ManagedMappedFile();
+
+	ManagedMappedFile(const ManagedMappedFile&) = delete;
+	ManagedMappedFile(ManagedMappedFile&&) = delete;
+
+	bool Open(const char* path);
+	void Close();
+
+	bool Valid() const {
+		return m_data != nullptr;
+	};
+
+	const char* Data() const {
+		return m_data;
+	};
+
+	size_t Size() const {
+		return m_size;
+	};
+};
+
+//==============================================================================================//
+// ManagedReflectionCache
+//      On-disk index of an image's types and members, keyed by the image GUID.
+//      Lets classes and members be resolved by token instead of by walking metadata.
+//==============================================================================================//
+struct ReflectionCacheHeader_t
+{
+	char magic[4];
+	uint32_t version;
+	char guid[40];
+	uint32_t typeCount;
+	uint32_t memberCount;
+	uint32_t stringsSize;
+	uint32_t reserved;
+};
+
+/* Sorted by hash */
+struct ReflectionCacheType_t
+{
+	uint64_t hash; // HashTypeName(ns, name)
+	uint32_t ns;   // Offsets into the string table
+	uint32_t name;
+	uint32_t token;
+	uint32_t firstMember;
+	uint32_t memberCount;
+	uint32_t reserved;
+};
+
+enum EReflectionCacheMemberKind : uint8_t
+{
+	CACHE_MEMBER_METHOD = 0,
+	CACHE_MEMBER_FIELD = 1,
+};
+
+/* Grouped by declaring type, in declaration order */
+struct ReflectionCacheMember_t
+{
+	uint64_t hash;			// HashString(name)
+	uint64_t signatureHash; // Canonical signature hash for methods, as in ManagedSignatureDesc_t
+	uint32_t name;
+	uint32_t token;
+	uint16_t arity;
+	uint8_t kind;
+	uint8_t reserved[5];
+};
+
+class ManagedReflectionCache
+{
+private:
+	ManagedMappedFile m_file;
+	const ReflectionCacheHeader_t* m_header;
+	const ReflectionCacheType_t* m_types;
+	const ReflectionCacheMember_t* m_members;
+	const char* m_strings;
+
+public:
+	static constexpr uint32_t Version = 1;
+
+	ManagedReflectionCache();
+
+	/* Cache file for image inside of dir */
+	static std::string PathFor(const std::string& dir, MonoImage* image);
+
+	/* Decodes the metadata of image and writes it to path. Loads every class in the image */
+	static bool Write(const std::string& path, MonoImage* image);
+
+	/* Maps the cache at path. Fails if it's missing, malformed or was written for a different image */
+	bool Open(const std::string& path, MonoImage* image);
+	void Close();
+
+	bool Valid() const {
+		return m_header != nullptr;
+	};
+
+	uint32_t TypeCount() const {
+		return m_header ? m_header->typeCount : 0;
+	};
+
+	const ReflectionCacheType_t& Type(uint32_t index) const {
+		return m_types[index];
+	};
+
+	const char* String(uint32_t offset) const {
+		return offset < m_header->stringsSize ? m_strings + offset : "";
+	};
+
+	const ReflectionCacheType_t* FindType(std::string_view ns, std::string_view cls) const;
+
+	/* Calls fn(const ReflectionCacheMember_t&) for the members of type called name, in declaration order.
+	 * Stops early if fn returns false */
+	template <class F>
+	void ForEachMember(const ReflectionCacheType_t& type, EReflectionCacheMemberKind kind, std::string_view name,
+					   F&& fn) const {
+		uint64_t hash = HashString(name);
+		for (uint32_t i = type.firstMember; i < type.firstMember + type.memberCount; i++) {
+			const ReflectionCacheMember_t& m = m_members[i];
+			if (m.kind == kind && m.hash == hash && name == String(m.name)) {
+				if (!fn(m))
+					return;
+			}
+		}
+	}
+};
+
+//==============================================================================================//
+// ManagedScriptBundle
+//      Single memory-mapped archive of assembly images, indexed by assembly name.
+//      Registered bundles also satisfy assembly references through mono's preload hook.
+//==============================================================================================//
+struct ScriptBundleHeader_t
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t stringsSize;
+};
+
+/* Sorted by hash. Images follow the string table, 16 byte aligned */
+struct ScriptBundleEntry_t
+{
+	uint64_t hash; // HashString(name)
+	uint64_t offset;
+	uint64_t size;
+	uint32_t name; // Offset into the string table
+	uint32_t reserved;
+	char guid[40];
+};
+
+class ManagedScriptBundle
+{
+private:
+	ManagedMappedFile m_file;
+	std::string m_path;
+	const ScriptBundleHeader_t* m_header;
+	const ScriptBundleEntry_t* m_entries;
+	const char* m_strings;
+
+	/* Assemblies loaded out of this bundle, by entry index. Loaded at most once */
+	std::unordered_map<uint32_t, MonoAssembly*> m_loaded;
+	std::recursive_mutex m_loadMutex; // Loading may resolve references through the preload hook
+
+public:
+	static constexpr uint32_t Version = 1;
+
+	ManagedScriptBundle();
+	ManagedScriptBundle(const ManagedScriptBundle&) = delete;
+	ManagedScriptBundle(ManagedScriptBundle&&) = delete;
+
+	/* Packs the assemblies at paths into a bundle at path. Entries are named after the assembly,
+	 * so this needs the runtime to be up to open the images */
+	static bool Write(const std::string& path, const std::vector<std::string>& assemblies);
+
+	bool Open(const std::string& path);
+
+	const std::string& Path() const {
+		return m_path;
+	};
+
+	uint32_t EntryCount() const {
+		return m_header ? m_header->entryCount : 0;
+	};
+
+	const ScriptBundleEntry_t& Entry(uint32_t index) const {
+		return m_entries[index];
+	};
+
+	const char* Name(const ScriptBundleEntry_t& entry) const {
+		return entry.name < m_header->stringsSize ? m_strings + entry.name : "";
+	};
+
+	const char* Data(const ScriptBundleEntry_t& entry) const {
+		return m_file.Data() + entry.offset;
+	};
+
+	const ScriptBundleEntry_t* Find(std::string_view name) const;
+
+	/* Opens the named image in place and loads its assembly, or returns the one loaded before */
+	MonoAssembly* Load(std::string_view name);
+};
+
 //==============================================================================================//
 // ManagedAssembly
 //      Represents an Assembly object
@@ -133,10 +421,23 @@ private:
 	MonoAssembly* m_assembly;
 	MonoImage* m_image;
 	std::string m_path;
-	std::unordered_multimap<std::string, class ManagedClass*> m_classes;
+	std::unordered_multimap<uint64_t, class ManagedClass*> m_classes; // Keyed by HashTypeName
 	bool m_populated;
 	class ManagedScriptContext* m_ctx;
 
+	/* Owns every reflection wrapper of this assembly and their names and member lists.
+	 * Disposing the reflection info runs destructors and releases it all at once */
+	std::pmr::monotonic_buffer_resource m_arena;
+
+	ManagedReflectionCache m_reflectionCache;
+
+	/* Backs m_image when loaded through LoadAssemblyMapped. Mono may keep the image alive
+	 * after Unload, so the mapping lives as long as this object */
+	std::unique_ptr<ManagedMappedFile> m_mappedImage;
+
+	/* Loaded from a ManagedScriptBundle, which keeps the image and assembly open */
+	bool m_bundled = false;
+
 public:
 	ManagedAssembly() = delete;
 	ManagedAssembly(ManagedAssembly&) = delete;
@@ -151,14 +452,38 @@ protected:
 	friend class ManagedClass;
 	friend class ManagedMethod;
 
-	void PopulateReflectionInfo();
+	void PopulateReflectionInfo(bool ownTypesOnly = false);
 	void DisposeReflectionInfo();
+	void LoadReflectionCache();
+
+	template <class T, class... ArgsT> T* Allocate(ArgsT&&... args) {
+		void* mem = m_arena.allocate(sizeof(T), alignof(T));
+		return new (mem) T(std::forward<ArgsT>(args)...);
+	}
+
+	/* Runs the destructor only, the memory goes back when the arena is released */
+	template <class T> void Destroy(T* obj) {
+		if (obj)
+			obj->~T();
+	}
 
 public:
+	std::pmr::memory_resource* Arena() {
+		return &m_arena;
+	};
+
 	void GetReferencedTypes(std::vector<std::string>& refList);
 
 	bool ValidateAgainstWhitelist(const std::vector<std::string>& whiteList);
 
+	const ManagedReflectionCache& ReflectionCache() const {
+		return m_reflectionCache;
+	};
+
+	class ManagedScriptContext& Context() const {
+		return *m_ctx;
+	};
+
 	/* Invalidates all internal data and unloads the assembly */
 	/* Delete the object after this */
 	void Unload();
@@ -179,7 +504,7 @@ private:
 	bool m_isVoid : 1;
 	bool m_isRef : 1;
 	bool m_isPtr : 1;
-	std::string m_name;
+	std::pmr::string m_name;
 
 public:
 	ManagedType() = delete;
@@ -187,10 +512,11 @@ public:
 	ManagedType(ManagedType&&) = delete;
 
 protected:
-	ManagedType(MonoType* type);
+	ManagedType(MonoType* type, std::pmr::memory_resource* arena);
 
 	friend class ManagedMethod;
 	friend class ManagedObject;
+	friend class ManagedAssembly;
 
 public:
 	bool IsStruct() const {
@@ -211,7 +537,7 @@ public:
 
 	bool Equals(const ManagedType* other) const;
 
-	const std::string& Name() const;
+	std::string_view Name() const;
 
 	inline MonoType* RawType() const {
 		return m_type;
@@ -244,31 +570,132 @@ enum class EManagedObjectHandleType
 	WEAKREF = 2,
 };
 
+using ManagedObjectHandle = uint32_t;
+
+inline ManagedObjectHandle NewGCHandle(MonoObject* obj, EManagedObjectHandleType type) {
+	if (!obj)
+		return 0;
+	switch (type) {
+	case EManagedObjectHandleType::HANDLE:
+		return mono_gchandle_new(obj, false);
+	case EManagedObjectHandleType::HANDLE_PINNED:
+		return mono_gchandle_new(obj, true);
+	case EManagedObjectHandleType::WEAKREF:
+		return mono_gchandle_new_weakref(obj, false);
+	default:
+		return 0;
+	}
+}
+
+//==============================================================================================//
+// ObjectRef
+//      GC handle to a mono object with the handle type fixed at compile time.
+//      Pinned refs keep the address around so dereferencing them is a load, the others
+//      resolve the handle. Copies take out a new handle to the same object.
+//==============================================================================================//
+template <EManagedObjectHandleType Type> class ObjectRef
+{
+private:
+	MonoObject* m_obj; // Only kept for pinned handles, the address may change otherwise
+	ManagedObjectHandle m_gcHandle;
+
+	static constexpr bool Pinned = Type == EManagedObjectHandleType::HANDLE_PINNED;
+
+public:
+	ObjectRef() : m_obj(nullptr), m_gcHandle(0) {
+	}
+
+	explicit ObjectRef(MonoObject* obj) : m_obj(Pinned ? obj : nullptr), m_gcHandle(NewGCHandle(obj, Type)) {
+	}
+
+	ObjectRef(const ObjectRef& other) : ObjectRef(other.Get()) {
+	}
+
+	ObjectRef(ObjectRef&& other) noexcept : m_obj(other.m_obj), m_gcHandle(other.m_gcHandle) {
+		other.m_obj = nullptr;
+		other.m_gcHandle = 0;
+	}
+
+	~ObjectRef() {
+		Reset();
+	}
+
+	ObjectRef& operator=(const ObjectRef& other) {
+		if (this != &other)
+			*this = ObjectRef(other);
+		return *this;
+	}
+
+	ObjectRef& operator=(ObjectRef&& other) noexcept {
+		if (this != &other) {
+			Reset();
+			m_obj = other.m_obj;
+			m_gcHandle = other.m_gcHandle;
+			other.m_obj = nullptr;
+			other.m_gcHandle = 0;
+		}
+		return *this;
+	}
+
+	void Reset() {
+		if (m_gcHandle)
+			mono_gchandle_free(m_gcHandle);
+		m_obj = nullptr;
+		m_gcHandle = 0;
+	}
+
+	MonoObject* Get() const {
+		if constexpr (Pinned)
+			return m_obj;
+		else
+			return m_gcHandle ? mono_gchandle_get_target(m_gcHandle) : nullptr;
+	}
+
+	MonoObject* operator*() const {
+		return Get();
+	}
+
+	/* Always true for live strong handles, weak ones go false once the object is collected */
+	explicit operator bool() const {
+		return Get() != nullptr;
+	}
+
+	ManagedObjectHandle GCHandle() const {
+		return m_gcHandle;
+	}
+};
+
+using PinnedObjectRef = ObjectRef<EManagedObjectHandleType::HANDLE_PINNED>;
+using StrongObjectRef = ObjectRef<EManagedObjectHandleType::HANDLE>;
+using WeakObjectRef = ObjectRef<EManagedObjectHandleType::WEAKREF>;
+
+static_assert(sizeof(PinnedObjectRef) <= 16, "ObjectRef should stay a pointer and a handle");
+
 //==============================================================================================//
 // ManagedObject
 //      Wrapper around a mono object
 //      Unlike the other classes here, the managed object can be copied around.
-//      It's just a wrapper around a MonoObject.
+//      It's just a wrapper around a MonoObject. Copies hold their own GC handle of the same type.
 //==============================================================================================//
-using ManagedObjectHandle = uint32_t;
 class ManagedObject : public ManagedBase<ManagedObject>
 {
 private:
-	MonoObject* m_obj;
+	MonoObject* m_obj; // Only valid for pinned handles
 	class ManagedClass* m_class;
-	uint32_t m_gcHandle = 0;
+	ManagedObjectHandle m_gcHandle = 0;
 	EManagedObjectHandleType m_handleType = EManagedObjectHandleType::HANDLE_PINNED;
 
-	std::function<MonoObject*()> m_getObject;
-
 	friend class ManagedClass;
 	friend class ManagedMethod;
 	friend class ManagedScriptContext;
+	friend class ManagedUpdateRegistry;
 
 public:
 	ManagedObject() = delete;
-	ManagedObject(const ManagedObject& other) = delete;
-	ManagedObject(ManagedObject&& other) = delete;
+	ManagedObject(const ManagedObject& other);
+	ManagedObject(ManagedObject&& other) noexcept;
+	ManagedObject& operator=(const ManagedObject& other);
+	ManagedObject& operator=(ManagedObject&& other) noexcept;
 
 	explicit ManagedObject(MonoObject* obj, class ManagedClass& cls,
 						   EManagedObjectHandleType type = EManagedObjectHandleType::HANDLE_PINNED);
@@ -279,10 +706,12 @@ public:
 	}
 
 	const MonoObject* RawObject() const {
-		return m_getObject();
+		return const_cast<ManagedObject*>(this)->RawObject();
 	};
 	MonoObject* RawObject() {
-		return m_getObject();
+		if (m_handleType == EManagedObjectHandleType::HANDLE_PINNED)
+			return m_obj;
+		return m_gcHandle ? mono_gchandle_get_target(m_gcHandle) : nullptr;
 	};
 
 	ManagedObjectHandle GCHandle() {
@@ -298,14 +727,268 @@ public:
 	bool GetProperty(class ManagedProperty& prop, void** outValue);
 	bool GetField(class ManagedField& prop, void* outValue);
 
-	bool SetProperty(const std::string& p, void* value);
-	bool SetField(const std::string& p, void* value);
-	bool GetProperty(const std::string& p, void** outValue);
-	bool GetField(const std::string& p, void* outValue);
+	bool SetProperty(std::string_view p, void* value);
+	bool SetField(std::string_view p, void* value);
+	bool GetProperty(std::string_view p, void** outValue);
+	bool GetField(std::string_view p, void* outValue);
 
 	MonoObject* Invoke(class ManagedMethod* method, void** params);
 };
 
+//==============================================================================================//
+// ManagedSignature
+//      Compile-time description of a managed method signature built from C++ types.
+//      ManagedSignature<void(int32_t, float, MonoString*)>::Desc can be matched against
+//      a method without any allocation.
+//==============================================================================================//
+
+template <class T> struct ManagedDependentFalse : std::false_type
+{};
+
+/* Maps a C++ type to the MonoTypeEnum it is passed as.
+ * MonoObject* stands in for any reference type, other pointers for pointers and byrefs,
+ * and non-primitive classes for value types */
+template <class T> constexpr MonoTypeEnum ManagedTypeEnumOf() {
+	using U = std::remove_cv_t<T>;
+	if constexpr (std::is_void_v<U>)
+		return MONO_TYPE_VOID;
+	else if constexpr (std::is_same_v<U, bool>)
+		return MONO_TYPE_BOOLEAN;
+	else if constexpr (std::is_same_v<U, char16_t>)
+		return MONO_TYPE_CHAR;
+	else if constexpr (std::is_enum_v<U>)
+		return ManagedTypeEnumOf<std::underlying_type_t<U>>();
+	else if constexpr (std::is_integral_v<U>) {
+		if constexpr (sizeof(U) == 1)
+			return std::is_signed_v<U> ? MONO_TYPE_I1 : MONO_TYPE_U1;
+		else if constexpr (sizeof(U) == 2)
+			return std::is_signed_v<U> ? MONO_TYPE_I2 : MONO_TYPE_U2;
+		else if constexpr (sizeof(U) == 4)
+			return std::is_signed_v<U> ? MONO_TYPE_I4 : MONO_TYPE_U4;
+		else
+			return std::is_signed_v<U> ? MONO_TYPE_I8 : MONO_TYPE_U8;
+	} else if constexpr (std::is_same_v<U, float>)
+		return MONO_TYPE_R4;
+	else if constexpr (std::is_same_v<U, double>)
+		return MONO_TYPE_R8;
+	else if constexpr (std::is_same_v<U, MonoString*>)
+		return MONO_TYPE_STRING;
+	else if constexpr (std::is_same_v<U, MonoArray*>)
+		return MONO_TYPE_SZARRAY;
+	else if constexpr (std::is_same_v<U, MonoObject*> || std::is_same_v<U, MonoException*>)
+		return MONO_TYPE_OBJECT;
+	else if constexpr (std::is_pointer_v<U>)
+		return MONO_TYPE_PTR;
+	else if constexpr (std::is_class_v<U>)
+		return MONO_TYPE_VALUETYPE;
+	else
+		static_assert(ManagedDependentFalse<T>::value, "Type has no managed equivalent");
+}
+
+/* Size a value type parameter must have on the managed side, 0 for anything that isn't passed as one */
+template <class T> constexpr uint32_t ManagedValueSizeOf() {
+	if constexpr (ManagedTypeEnumOf<T>() == MONO_TYPE_VALUETYPE)
+		return sizeof(T);
+	else
+		return 0;
+}
+
+/* Collapses type enums that are interchangeable at the ABI level. Used for hashing, so that a
+ * C++ signature and the managed signature it matches always hash the same */
+constexpr MonoTypeEnum ManagedCanonicalTypeEnum(MonoTypeEnum type) {
+	switch (type) {
+	case MONO_TYPE_BOOLEAN:
+		return MONO_TYPE_U1;
+	case MONO_TYPE_CHAR:
+		return MONO_TYPE_U2;
+	case MONO_TYPE_I:
+		return sizeof(void*) == 8 ? MONO_TYPE_I8 : MONO_TYPE_I4;
+	case MONO_TYPE_U:
+		return sizeof(void*) == 8 ? MONO_TYPE_U8 : MONO_TYPE_U4;
+	case MONO_TYPE_STRING:
+	case MONO_TYPE_CLASS:
+	case MONO_TYPE_SZARRAY:
+	case MONO_TYPE_ARRAY:
+	case MONO_TYPE_OBJECT:
+		return MONO_TYPE_OBJECT;
+	case MONO_TYPE_BYREF:
+	case MONO_TYPE_FNPTR:
+		return MONO_TYPE_PTR;
+	default:
+		return type;
+	}
+}
+
+struct ManagedSignatureDesc_t
+{
+	MonoTypeEnum returnType;
+	const MonoTypeEnum* params;
+	int paramCount;
+	uint64_t hash;			// Hash of the exact type enums, identifies the C++ signature
+	uint64_t canonicalHash; // Hash of the canonical type enums, comparable with ManagedMethod::SignatureHash
+	uint32_t returnSize;	// Value type sizes, as ManagedValueSizeOf
+	const uint32_t* paramSizes;
+};
+
+constexpr uint64_t HashSignature(MonoTypeEnum ret, const MonoTypeEnum* params, int count, bool canonical) {
+	uint64_t hash = HashCombine(0xcbf29ce484222325ULL, canonical ? ManagedCanonicalTypeEnum(ret) : ret);
+	hash = HashCombine(hash, count);
+	for (int i = 0; i < count; i++)
+		hash = HashCombine(hash, canonical ? ManagedCanonicalTypeEnum(params[i]) : params[i]);
+	return hash;
+}
+
+template <class Sig> struct ManagedSignature;
+
+template <class R, class... Args> struct ManagedSignature<R(Args...)>
+{
+	/* Terminated with MONO_TYPE_END so that the array is never zero sized */
+	static constexpr MonoTypeEnum Params[] = {ManagedTypeEnumOf<Args>()..., MONO_TYPE_END};
+	static constexpr MonoTypeEnum Return = ManagedTypeEnumOf<R>();
+	static constexpr int ParamCount = sizeof...(Args);
+	static constexpr uint32_t ParamSizes[] = {ManagedValueSizeOf<Args>()..., 0};
+
+	static constexpr ManagedSignatureDesc_t Desc = {Return,
+													Params,
+													ParamCount,
+													HashSignature(Return, Params, ParamCount, false),
+													HashSignature(Return, Params, ParamCount, true),
+													ManagedValueSizeOf<R>(),
+													ParamSizes};
+};
+
+/* Signature of an instance method thunk with the leading 'this' dropped, as the managed method declares it */
+template <class Sig> struct ManagedThisSignature : ManagedSignature<Sig>
+{
+	static constexpr bool ValidThis = false;
+};
+
+template <class R, class Self, class... Args>
+struct ManagedThisSignature<R(Self, Args...)> : ManagedSignature<R(Args...)>
+{
+	static constexpr bool ValidThis = ManagedTypeEnumOf<Self>() == MONO_TYPE_OBJECT;
+};
+
+//==============================================================================================//
+// ManagedMemberIndex
+//      Open-addressing index of class members keyed by (name hash, arity).
+//      All overloads of a name share a probe sequence, in declaration order, so the first
+//      hit for a name is the first declared member with that name.
+//==============================================================================================//
+template <class T> class ManagedMemberIndex
+{
+private:
+	struct Slot_t
+	{
+		uint64_t hash;
+		T* member; // nullptr marks an empty slot
+		int arity;
+		uint32_t sequence; // Insertion order
+	};
+
+	std::vector<Slot_t> m_slots;
+	size_t m_count = 0;
+	uint32_t m_nextSequence = 0;
+
+	size_t Mask() const {
+		return m_slots.size() - 1;
+	}
+
+	void Grow() {
+		std::vector<Slot_t> old;
+		old.swap(m_slots);
+		m_slots.assign(old.empty() ? 16 : old.size() * 2, Slot_t{0, nullptr, 0, 0});
+		m_count = 0;
+
+		/* Probe chains can wrap past the end of the table, so walking the old slots in order would
+		 * reinsert overloads out of declaration order */
+		old.erase(std::remove_if(old.begin(), old.end(), [](const Slot_t& slot) { return !slot.member; }), old.end());
+		std::sort(old.begin(), old.end(), [](const Slot_t& a, const Slot_t& b) { return a.sequence < b.sequence; });
+		for (auto& slot : old)
+			InsertHashed(slot);
+	}
+
+	void InsertHashed(const Slot_t& slot) {
+		size_t i = slot.hash & Mask();
+		while (m_slots[i].member)
+			i = (i + 1) & Mask();
+		m_slots[i] = slot;
+		m_count++;
+	}
+
+public:
+	/* Any arity */
+	static constexpr int AnyArity = -1;
+
+	void Clear() {
+		m_slots.clear();
+		m_count = 0;
+		m_nextSequence = 0;
+	}
+
+	size_t Size() const {
+		return m_count;
+	}
+
+	void Insert(T* member, std::string_view name, int arity = 0) {
+		/* Keep the load factor under 1/2 so probe sequences stay short */
+		if ((m_count + 1) * 2 > m_slots.size())
+			Grow();
+		InsertHashed({HashString(name), member, arity, m_nextSequence++});
+	}
+
+	/* Calls fn(T*) for every member called name with the given arity, in declaration order.
+	 * Stops early if fn returns false */
+	template <class F> void ForEach(std::string_view name, int arity, F&& fn) const {
+		if (m_slots.empty())
+			return;
+		uint64_t hash = HashString(name);
+		for (size_t i = hash & Mask(); m_slots[i].member; i = (i + 1) & Mask()) {
+			const Slot_t& slot = m_slots[i];
+			if (slot.hash == hash && (arity == AnyArity || slot.arity == arity) && slot.member->Name() == name) {
+				if (!fn(slot.member))
+					return;
+			}
+		}
+	}
+
+	T* Find(std::string_view name, int arity = AnyArity) const {
+		T* found = nullptr;
+		ForEach(name, arity, [&found](T* m) {
+			found = m;
+			return false;
+		});
+		return found;
+	}
+};
+
+template <class Sig> class ManagedThunk;
+template <class Sig> class ManagedConstructor;
+template <class Sig> class VirtualCallSite;
+template <class T> class StaticFieldAccessor;
+
+/* What ManagedMethod::InvokeBatch does when an element throws */
+enum class EBatchExceptionPolicy
+{
+	SKIP,	 // Carry on with the next element, only the first exception is reported
+	STOP,	 // Report the exception and leave the rest of the batch uninvoked
+	COLLECT, // Carry on and return every exception in the result, none are reported
+};
+
+struct ManagedBatchException_t
+{
+	size_t index;
+	StrongObjectRef exception;
+};
+
+struct ManagedBatchResult_t
+{
+	size_t invoked = 0;		// Elements the method was called on
+	size_t failed = 0;		// Calls that threw
+	size_t nullObjects = 0; // Elements skipped because they had no object
+	std::vector<ManagedBatchException_t> exceptions; // COLLECT only
+};
+
 //==============================================================================================//
 // ManagedMethod
 //      Represents a MonoMethod object, must be a part of a class
@@ -316,19 +999,26 @@ private:
 	MonoMethod* m_method;
 	class ManagedClass* m_class;
 	std::vector<class ManagedObject*> m_attributes;
-	MonoCustomAttrInfo* m_attrInfo;
+	MonoCustomAttrInfo* m_attrInfo; // Resolved on first use
 	MonoMethodSignature* m_signature;
 	bool m_populated;
+	bool m_attrInfoResolved;
 	uint32_t m_token;
-	std::string m_name;
-	std::string m_fullyQualifiedName;
+	std::pmr::string m_name;
 	int m_paramCount;
+	bool m_instance;
+	void* m_thunk;
+	uint64_t m_signatureHash;
 
-	ManagedType* m_returnType;
+	ManagedType* m_returnType; // Created on first use
 	std::vector<ManagedType*> m_params;
 
 	friend class ManagedClass;
 	friend ManagedHandle<ManagedMethod>;
+	template <class Sig> friend class ManagedThunk;
+	template <class Sig> friend class ManagedConstructor;
+	template <class Sig> friend class VirtualCallSite;
+	friend class ManagedUpdateRegistry;
 
 public:
 	ManagedMethod() = delete;
@@ -343,9 +1033,12 @@ protected:
 	friend class ExecutionContext;
 	friend class ManagedClass;
 	friend class ManagedObject;
+	friend class ManagedAssembly;
 
 	void InvalidateHandle() override;
 
+	void ReportException(MonoObject* exc);
+
 public:
 	ManagedAssembly& Assembly() const;
 
@@ -355,7 +1048,7 @@ public:
 		return m_attributes;
 	}
 
-	const std::string& Name() const {
+	std::string_view Name() const {
 		return m_name;
 	};
 
@@ -363,45 +1056,408 @@ public:
 		return m_paramCount;
 	};
 
+	ManagedType& ReturnType();
+
+	/* Custom attribute info for use with the mono_custom_attrs_* API, may be null */
+	MonoCustomAttrInfo* RawAttributeInfo();
+
+	/* True if the method takes an implicit 'this' */
+	bool IsInstance() const {
+		return m_instance;
+	};
+
 	MonoMethod* RawMethod() {
 		return m_method;
 	};
 
-	bool MatchSignature(MonoType* returnval, std::vector<MonoType*> params);
-	bool MatchSignature(std::vector<MonoType*> params);
+	/* Returns the unmanaged-to-managed thunk for this method. Resolved once and cached */
+	void* UnmanagedThunk();
+
+	/* Binds the method to a typed native callable, bypassing mono_runtime_invoke.
+	 * Arguments and return values are passed unboxed, exactly as the thunk expects them:
+	 * primitives and blittable structs by value, reference types as raw object pointers (MonoObject*, MonoString*, ...).
+	 * For instance methods the first argument must be the 'this' object (MonoObject*).
+	 * Returns an invalid thunk if the signature does not match */
+	template <class Sig> ManagedThunk<Sig> Bind();
+
+	/* Call site dispatching this virtual or interface method to the receiver's override.
+	 * Sig leaves out 'this', e.g. BindVirtual<float(int32_t)>() for an instance float M(int).
+	 * Returns an invalid call site for static methods or if the signature does not match */
+	template <class Sig> VirtualCallSite<Sig> BindVirtual();
+
+	bool MatchSignature(MonoType* returnval, const std::vector<MonoType*>& params);
+	bool MatchSignature(const std::vector<MonoType*>& params);
 	bool MatchSignature();
 
+	/* Checks the method against a compile-time signature. Does not allocate */
+	bool MatchSignature(const ManagedSignatureDesc_t& sig);
+	template <class Sig> bool MatchSignature() {
+		return MatchSignature(ManagedSignature<Sig>::Desc);
+	}
+
+	/* Canonical hash of the signature, as in ManagedSignatureDesc_t::canonicalHash. Computed on first use */
+	uint64_t SignatureHash();
+
 	MonoObject* Invoke(ManagedObject* obj, void** params, MonoObject** exception = nullptr);
 	MonoObject* InvokeStatic(void** params, MonoObject** exception = nullptr);
+
+	/* Calls this instance method on each of the objects in turn. args(i) returns the params for
+	 * objects[i], as passed to Invoke. Parameterless void methods skip mono_runtime_invoke and go
+	 * through the unmanaged thunk, which is resolved once for the whole batch. Others are better served
+	 * by the typed overload below. Return values are discarded. Exceptions are handled as the policy
+	 * says instead of each one being reported */
+	template <class ArgProviderT>
+	ManagedBatchResult_t InvokeBatch(ManagedObject* const* objects, size_t count, ArgProviderT&& args,
+									 EBatchExceptionPolicy policy = EBatchExceptionPolicy::SKIP);
+
+	ManagedBatchResult_t InvokeBatch(ManagedObject* const* objects, size_t count,
+									 EBatchExceptionPolicy policy = EBatchExceptionPolicy::SKIP) {
+		return InvokeBatch(objects, count, [](size_t) -> void** { return nullptr; }, policy);
+	}
+
+	ManagedBatchResult_t InvokeBatch(const std::vector<ManagedObject*>& objects,
+									 EBatchExceptionPolicy policy = EBatchExceptionPolicy::SKIP) {
+		return InvokeBatch(objects.data(), objects.size(), policy);
+	}
+
+	/* Typed batch. Sig is the thunk signature with the receiver first, as for Bind, e.g. void(MonoObject*, int32_t).
+	 * The method is bound once and args(i) returns a std::tuple of the remaining arguments for objects[i], so no
+	 * element goes through mono_runtime_invoke. Nothing is invoked if the method doesn't match Sig */
+	template <class Sig, class ArgProviderT>
+	ManagedBatchResult_t InvokeBatch(ManagedObject* const* objects, size_t count, ArgProviderT&& args,
+									 EBatchExceptionPolicy policy = EBatchExceptionPolicy::SKIP);
+
+private:
+	/* Shared loop of the InvokeBatch overloads. invoke(i, obj) calls the method and returns what it threw */
+	template <class InvokeT>
+	ManagedBatchResult_t RunBatch(ManagedObject* const* objects, size_t count, EBatchExceptionPolicy policy,
+								  InvokeT&& invoke);
 };
 
+template <class ArgProviderT>
+ManagedBatchResult_t ManagedMethod::InvokeBatch(ManagedObject* const* objects, size_t count, ArgProviderT&& args,
+												EBatchExceptionPolicy policy) {
+	using ThunkT = void (*)(MonoObject*, MonoException**);
+	ThunkT thunk = nullptr;
+	if (m_instance && m_paramCount == 0 && ReturnType().IsVoid())
+		thunk = reinterpret_cast<ThunkT>(UnmanagedThunk());
+
+	return RunBatch(objects, count, policy, [&](size_t i, MonoObject* obj) {
+		MonoObject* exc = nullptr;
+		if (thunk) {
+			MonoException* thrown = nullptr;
+			thunk(obj, &thrown);
+			exc = reinterpret_cast<MonoObject*>(thrown);
+		}
+		else
+			mono_runtime_invoke(m_method, obj, args(i), &exc);
+		return exc;
+	});
+}
+
+template <class InvokeT>
+ManagedBatchResult_t ManagedMethod::RunBatch(ManagedObject* const* objects, size_t count, EBatchExceptionPolicy policy,
+											 InvokeT&& invoke) {
+	ManagedBatchResult_t result;
+	for (size_t i = 0; i < count; i++) {
+		MonoObject* obj = objects[i] ? objects[i]->RawObject() : nullptr;
+		if (!obj) {
+			result.nullObjects++;
+			continue;
+		}
+
+		MonoObject* exc = invoke(i, obj);
+		result.invoked++;
+		if (!exc)
+			continue;
+
+		result.failed++;
+		if (policy == EBatchExceptionPolicy::COLLECT)
+			result.exceptions.push_back({i, StrongObjectRef(exc)});
+		else if (result.failed == 1)
+			ReportException(exc);
+		if (policy == EBatchExceptionPolicy::STOP)
+			break;
+	}
+	return result;
+}
+
 //==============================================================================================//
-// ManagedField
-//      Represents a MonoField, or a field in a class
+// ManagedThunk
+//      Typed native callable bound to a managed method through its unmanaged thunk.
+//      Cheap to copy, valid for as long as the method it was bound from.
 //==============================================================================================//
-class ManagedField : public ManagedBase<ManagedField>
+template <class R, class... Args> class ManagedThunk<R(Args...)>
 {
 private:
-	MonoClassField& m_field;
-	class ManagedClass& m_class;
-	std::string m_name;
+	using FuncT = R (*)(Args..., MonoException**);
+
+	FuncT m_func;
+	ManagedMethod* m_method;
 
 public:
-	ManagedField() = delete;
-	ManagedField(ManagedField&) = delete;
-	ManagedField(ManagedField&&) = delete;
+	static constexpr int Arity = sizeof...(Args);
 
-	inline ManagedClass& Class() const {
+	ManagedThunk() : m_func(nullptr), m_method(nullptr) {
+	}
+
+	ManagedThunk(ManagedMethod* method, void* thunk) : m_func(reinterpret_cast<FuncT>(thunk)), m_method(method) {
+	}
+
+	bool Valid() const {
+		return m_func != nullptr;
+	};
+
+	explicit operator bool() const {
+		return Valid();
+	};
+
+	ManagedMethod* Method() const {
+		return m_method;
+	};
+
+	/* Calls the method. Exceptions are reported through the owning context,
+	 * in which case a value-initialized R is returned */
+	R operator()(Args... args) const {
+		MonoObject* exc = nullptr;
+		if constexpr (std::is_void_v<R>) {
+			Invoke(&exc, args...);
+			if (exc)
+				m_method->ReportException(exc);
+		} else {
+			R ret = Invoke(&exc, args...);
+			if (exc) {
+				m_method->ReportException(exc);
+				return R{};
+			}
+			return ret;
+		}
+	}
+
+	/* Calls the method, storing any raised exception in *exception instead of reporting it */
+	R Invoke(MonoObject** exception, Args... args) const {
+		MonoException* exc = nullptr;
+		if constexpr (std::is_void_v<R>) {
+			m_func(args..., &exc);
+			*exception = reinterpret_cast<MonoObject*>(exc);
+		} else {
+			R ret = m_func(args..., &exc);
+			*exception = reinterpret_cast<MonoObject*>(exc);
+			return exc ? R{} : ret;
+		}
+	}
+};
+
+template <class Sig> ManagedThunk<Sig> ManagedMethod::Bind() {
+	if (ManagedThunk<Sig>::Arity != m_paramCount + (m_instance ? 1 : 0))
+		return ManagedThunk<Sig>();
+	if (m_instance ? !ManagedThisSignature<Sig>::ValidThis || !MatchSignature(ManagedThisSignature<Sig>::Desc)
+				   : !MatchSignature(ManagedSignature<Sig>::Desc))
+		return ManagedThunk<Sig>();
+	void* thunk = UnmanagedThunk();
+	if (!thunk)
+		return ManagedThunk<Sig>();
+	return ManagedThunk<Sig>(this, thunk);
+}
+
+template <class Sig, class ArgProviderT>
+ManagedBatchResult_t ManagedMethod::InvokeBatch(ManagedObject* const* objects, size_t count, ArgProviderT&& args,
+												EBatchExceptionPolicy policy) {
+	static_assert(ManagedThisSignature<Sig>::ValidThis, "Sig must take the receiver as its first argument");
+	ManagedThunk<Sig> thunk = Bind<Sig>();
+	if (!thunk)
+		return ManagedBatchResult_t();
+
+	return RunBatch(objects, count, policy, [&](size_t i, MonoObject* obj) {
+		MonoObject* exc = nullptr;
+		std::apply([&](auto&&... params) { thunk.Invoke(&exc, obj, params...); }, args(i));
+		return exc;
+	});
+}
+
+//==============================================================================================//
+// VirtualCallSite
+//      Calls a virtual or interface method through the override of the receiver's class.
+//      Overrides are resolved with mono_object_get_virtual_method once per class and kept with
+//      their thunks in a small polymorphic inline cache, so dispatching is a scan of a few
+//      class pointers. Classes past the inline slots go to a per-site hash map instead of evicting.
+//      Keep one per call site, each cache then only sees that site's classes.
+//==============================================================================================//
+template <class R, class... Args> class VirtualCallSite<R(Args...)>
+{
+public:
+	using ThunkSig = R(MonoObject*, Args...);
+	/* Typical sites see a handful of receiver classes, those stay in the inline cache */
+	static constexpr int CacheSize = 8;
+
+private:
+	using FuncT = R (*)(MonoObject*, Args..., MonoException**);
+
+	MonoClass* m_classes[CacheSize];
+	FuncT m_funcs[CacheSize];
+	/* Classes seen after the inline cache filled up, so megamorphic sites still resolve each class once */
+	std::unordered_map<MonoClass*, FuncT> m_overflow;
+	ManagedMethod* m_method;
+	uint32_t m_misses;
+	uint8_t m_count; // Used inline slots
+
+	FuncT Lookup(MonoObject* self) {
+		MonoClass* cls = mono_object_get_class(self);
+		for (int i = 0; i < m_count; i++) {
+			if (m_classes[i] == cls)
+				return m_funcs[i];
+		}
+		if (!m_overflow.empty()) {
+			auto it = m_overflow.find(cls);
+			if (it != m_overflow.end())
+				return it->second;
+		}
+		return Miss(self, cls);
+	}
+
+	FuncT Miss(MonoObject* self, MonoClass* cls) {
+		m_misses++;
+		MonoMethod* target = mono_object_get_virtual_method(self, m_method->RawMethod());
+		void* thunk = target ? mono_method_get_unmanaged_thunk(target) : nullptr;
+		if (!thunk)
+			return nullptr;
+		FuncT func = reinterpret_cast<FuncT>(thunk);
+		if (m_count < CacheSize) {
+			m_classes[m_count] = cls;
+			m_funcs[m_count] = func;
+			m_count++;
+		}
+		else
+			m_overflow.insert({cls, func});
+		return func;
+	}
+
+public:
+	VirtualCallSite() : VirtualCallSite(nullptr) {
+	}
+
+	explicit VirtualCallSite(ManagedMethod* method)
+		: m_classes(), m_funcs(), m_method(method), m_misses(0), m_count(0) {
+	}
+
+	bool Valid() const {
+		return m_method != nullptr;
+	};
+
+	explicit operator bool() const {
+		return Valid();
+	};
+
+	/* The declaring method */
+	ManagedMethod* Method() const {
+		return m_method;
+	};
+
+	/* Receiver classes resolved so far, each one is only resolved once */
+	uint32_t Misses() const {
+		return m_misses;
+	};
+
+	/* The override self dispatches to, as a directly callable thunk. Invalid if it can't be resolved */
+	ManagedThunk<ThunkSig> Target(MonoObject* self) {
+		FuncT func = self ? Lookup(self) : nullptr;
+		return func ? ManagedThunk<ThunkSig>(m_method, reinterpret_cast<void*>(func)) : ManagedThunk<ThunkSig>();
+	}
+
+	/* Calls the override. Exceptions are reported through the owning context, in which case
+	 * a value-initialized R is returned. So is it for a null receiver */
+	R operator()(MonoObject* self, Args... args) {
+		MonoObject* exc = nullptr;
+		if constexpr (std::is_void_v<R>) {
+			Invoke(&exc, self, args...);
+			if (exc)
+				m_method->ReportException(exc);
+		} else {
+			R ret = Invoke(&exc, self, args...);
+			if (exc) {
+				m_method->ReportException(exc);
+				return R{};
+			}
+			return ret;
+		}
+	}
+
+	/* Calls the override, storing any raised exception in *exception instead of reporting it */
+	R Invoke(MonoObject** exception, MonoObject* self, Args... args) {
+		*exception = nullptr;
+		FuncT func = self ? Lookup(self) : nullptr;
+		if (!func) {
+			if constexpr (std::is_void_v<R>)
+				return;
+			else
+				return R{};
+		}
+
+		MonoException* exc = nullptr;
+		if constexpr (std::is_void_v<R>) {
+			func(self, args..., &exc);
+			*exception = reinterpret_cast<MonoObject*>(exc);
+		} else {
+			R ret = func(self, args..., &exc);
+			*exception = reinterpret_cast<MonoObject*>(exc);
+			return exc ? R{} : ret;
+		}
+	}
+};
+
+template <class Sig> VirtualCallSite<Sig> ManagedMethod::BindVirtual() {
+	if (!m_instance || ManagedThunk<Sig>::Arity != m_paramCount || !MatchSignature(ManagedSignature<Sig>::Desc))
+		return VirtualCallSite<Sig>();
+	return VirtualCallSite<Sig>(this);
+}
+
+//==============================================================================================//
+// ManagedField
+//      Represents a MonoField, or a field in a class
+//==============================================================================================//
+class ManagedField : public ManagedBase<ManagedField>
+{
+private:
+	MonoClassField& m_field;
+	class ManagedClass& m_class;
+	std::pmr::string m_name;
+
+public:
+	ManagedField() = delete;
+	ManagedField(ManagedField&) = delete;
+	ManagedField(ManagedField&&) = delete;
+
+	inline ManagedClass& Class() const {
 		return m_class;
 	};
 
 	inline MonoClassField& RawField() const {
 		return m_field;
 	};
-	const std::string& Name() const {
+	std::string_view Name() const {
 		return m_name;
 	}
 
+	bool IsStatic() const;
+
+	/* Byte offset of the field from the start of the (boxed) object, header included */
+	uint32_t Offset() const;
+
+	/* True if a C++ value of type expected (see ManagedTypeEnumOf) and size bytes can be stored in the field */
+	bool MatchType(MonoTypeEnum expected, size_t size) const;
+
+	/* Copies this field out of count objects into out, or from in back into them.
+	 * Handles are resolved in bulk before any copying, null objects read as T{} and are skipped on write.
+	 * Returns false if T doesn't match the field */
+	template <class T> bool Gather(ManagedObject* const* objects, size_t count, T* out) const;
+	template <class T> bool Scatter(ManagedObject* const* objects, size_t count, const T* in) const;
+
+	/* VTable holding a static field's storage, with the class initializer run. Null for instance fields */
+	MonoVTable* StaticVTable() const;
+
+	/* Accessor for this static field, see StaticFieldAccessor */
+	template <class T> StaticFieldAccessor<T> StaticAccessor() const;
+
 protected:
 	explicit ManagedField(MonoClassField& fld, class ManagedClass& cls);
 	~ManagedField();
@@ -409,6 +1465,373 @@ protected:
 	friend class ManagedClass;
 	friend class ManagedProperty;
 	friend class ManagedObject;
+	friend class ManagedAssembly;
+};
+
+//==============================================================================================//
+// FieldAccessor
+//      Typed instance field access at a fixed offset, resolved once from a ManagedField.
+//      Reads and writes go straight to object memory, reference fields are stored through
+//      the GC write barrier. Only call into it while the object address is stable, e.g. for
+//      pinned objects or with a freshly resolved RawObject().
+//==============================================================================================//
+template <class T> class FieldAccessor
+{
+private:
+	uint32_t m_offset;
+	bool m_valid;
+
+	static_assert(std::is_trivially_copyable_v<T>, "Fields can only be accessed as trivially copyable types");
+
+public:
+	/* Reference fields need a write barrier on store */
+	static constexpr bool IsReference = std::is_pointer_v<T> && (ManagedTypeEnumOf<T>() == MONO_TYPE_OBJECT ||
+																   ManagedTypeEnumOf<T>() == MONO_TYPE_STRING ||
+																   ManagedTypeEnumOf<T>() == MONO_TYPE_SZARRAY);
+
+	FieldAccessor() : m_offset(0), m_valid(false) {
+	}
+
+	explicit FieldAccessor(const ManagedField& field) : m_offset(0), m_valid(false) {
+		if (field.IsStatic() || !field.MatchType(ManagedTypeEnumOf<T>(), sizeof(T)))
+			return;
+		m_offset = field.Offset();
+		m_valid = true;
+	}
+
+	bool Valid() const {
+		return m_valid;
+	}
+
+	explicit operator bool() const {
+		return m_valid;
+	}
+
+	uint32_t Offset() const {
+		return m_offset;
+	}
+
+	T Get(MonoObject* obj) const {
+		T value;
+		memcpy(&value, reinterpret_cast<const char*>(obj) + m_offset, sizeof(T));
+		return value;
+	}
+
+	void Set(MonoObject* obj, const T& value) const {
+		void* dst = reinterpret_cast<char*>(obj) + m_offset;
+		if constexpr (IsReference)
+			mono_gc_wbarrier_set_field(obj, dst, reinterpret_cast<MonoObject*>(value));
+		else
+			memcpy(dst, &value, sizeof(T));
+	}
+
+	T Get(ManagedObject& obj) const {
+		return Get(obj.RawObject());
+	}
+
+	void Set(ManagedObject& obj, const T& value) const {
+		Set(obj.RawObject(), value);
+	}
+
+	/* Bulk versions over raw object pointers, see ManagedField::Gather/Scatter for handles */
+	void Gather(MonoObject* const* objects, size_t count, T* out) const {
+		for (size_t i = 0; i < count; i++) {
+			if (objects[i])
+				memcpy(out + i, reinterpret_cast<const char*>(objects[i]) + m_offset, sizeof(T));
+			else
+				out[i] = T{};
+		}
+	}
+
+	void Scatter(MonoObject* const* objects, size_t count, const T* in) const {
+		for (size_t i = 0; i < count; i++) {
+			if (objects[i])
+				Set(objects[i], in[i]);
+		}
+	}
+};
+
+//==============================================================================================//
+// StaticFieldAccessor
+//      Typed static field access. The vtable is resolved, the class initialized and the field
+//      type checked once, when the accessor is created. Each access is then a single
+//      mono_field_static_get_value or set_value call, with no lookups or runtime type checks.
+//      Thread static fields read and write the calling thread's copy.
+//==============================================================================================//
+template <class T> class StaticFieldAccessor
+{
+private:
+	MonoVTable* m_vtable;
+	MonoClassField* m_field;
+
+	static_assert(std::is_trivially_copyable_v<T>, "Fields can only be accessed as trivially copyable types");
+
+public:
+	StaticFieldAccessor() : m_vtable(nullptr), m_field(nullptr) {
+	}
+
+	explicit StaticFieldAccessor(const ManagedField& field) : m_vtable(nullptr), m_field(nullptr) {
+		if (!field.IsStatic() || !field.MatchType(ManagedTypeEnumOf<T>(), sizeof(T)))
+			return;
+		if ((m_vtable = field.StaticVTable()))
+			m_field = &field.RawField();
+	}
+
+	bool Valid() const {
+		return m_field != nullptr;
+	}
+
+	explicit operator bool() const {
+		return Valid();
+	}
+
+	T Get() const {
+		T value {};
+		mono_field_static_get_value(m_vtable, m_field, &value);
+		return value;
+	}
+
+	/* Reference fields go through the GC write barrier */
+	void Set(const T& value) const {
+		if constexpr (FieldAccessor<T>::IsReference)
+			mono_field_static_set_value(m_vtable, m_field, reinterpret_cast<void*>(value));
+		else
+			mono_field_static_set_value(m_vtable, m_field, const_cast<T*>(&value));
+	}
+};
+
+template <class T> StaticFieldAccessor<T> ManagedField::StaticAccessor() const {
+	return StaticFieldAccessor<T>(*this);
+}
+
+/* Resolves handles a chunk at a time, so the copy loops only see plain pointers */
+static constexpr size_t FieldBatchChunkSize = 256;
+
+template <class T> bool ManagedField::Gather(ManagedObject* const* objects, size_t count, T* out) const {
+	FieldAccessor<T> accessor(*this);
+	if (!accessor)
+		return false;
+	MonoObject* raw[FieldBatchChunkSize];
+	for (size_t base = 0; base < count; base += FieldBatchChunkSize) {
+		size_t n = count - base < FieldBatchChunkSize ? count - base : FieldBatchChunkSize;
+		for (size_t i = 0; i < n; i++)
+			raw[i] = objects[base + i] ? objects[base + i]->RawObject() : nullptr;
+		accessor.Gather(raw, n, out + base);
+	}
+	return true;
+}
+
+template <class T> bool ManagedField::Scatter(ManagedObject* const* objects, size_t count, const T* in) const {
+	FieldAccessor<T> accessor(*this);
+	if (!accessor)
+		return false;
+	MonoObject* raw[FieldBatchChunkSize];
+	for (size_t base = 0; base < count; base += FieldBatchChunkSize) {
+		size_t n = count - base < FieldBatchChunkSize ? count - base : FieldBatchChunkSize;
+		for (size_t i = 0; i < n; i++)
+			raw[i] = objects[base + i] ? objects[base + i]->RawObject() : nullptr;
+		accessor.Scatter(raw, n, in + base);
+	}
+	return true;
+}
+
+//==============================================================================================//
+// ManagedArray
+//      Pinned, zero-copy view of a single dimensional managed array.
+//      Elements are read and written in place, bool and char arrays get vectorized
+//      bulk conversions from their usual native representations.
+//==============================================================================================//
+
+/* Class of a primitive element type, e.g. MONO_TYPE_I4 -> System.Int32. nullptr for anything else */
+MonoClass* ManagedPrimitiveClass(MonoTypeEnum type);
+
+/* New T[] of length elements. Array vtables are cached per element class and domain */
+MonoArray* NewManagedArray(MonoClass* elementClass, size_t length);
+
+/* Bulk conversions used by ManagedArray. Latin-1 narrowing clamps characters past U+00FF to 0xFF */
+void ConvertLatin1ToUtf16(const char* src, char16_t* dst, size_t count);
+void ConvertUtf16ToLatin1(const char16_t* src, char* dst, size_t count);
+/* Copies bools so that every byte of dst ends up 0 or 1, whatever the source held */
+void NormalizeBools(const bool* src, bool* dst, size_t count);
+
+template <class T> class ManagedArray
+{
+private:
+	PinnedObjectRef m_ref;
+	T* m_data;
+	size_t m_length;
+
+	static_assert(std::is_trivially_copyable_v<T>, "Array elements must be trivially copyable");
+
+public:
+	static constexpr bool IsReference = std::is_pointer_v<T> && (ManagedTypeEnumOf<T>() == MONO_TYPE_OBJECT ||
+																   ManagedTypeEnumOf<T>() == MONO_TYPE_STRING ||
+																   ManagedTypeEnumOf<T>() == MONO_TYPE_SZARRAY);
+
+	ManagedArray() : m_data(nullptr), m_length(0) {
+	}
+
+	/* Pins array for the lifetime of this view. The view is left empty unless the element size matches T,
+	 * and the elements are references exactly when T is one */
+	explicit ManagedArray(MonoArray* array)
+		: m_ref(reinterpret_cast<MonoObject*>(MatchElements(array))), m_data(nullptr), m_length(0) {
+		if (!RawArray())
+			return;
+		m_length = mono_array_length(RawArray());
+		m_data = reinterpret_cast<T*>(mono_array_addr_with_size(RawArray(), sizeof(T), 0));
+	}
+
+	/* array, or nullptr if its elements can't be viewed as T */
+	static MonoArray* MatchElements(MonoArray* array) {
+		if (!array)
+			return nullptr;
+		MonoClass* klass = mono_object_get_class(reinterpret_cast<MonoObject*>(array));
+		if (static_cast<size_t>(mono_array_element_size(klass)) != sizeof(T))
+			return nullptr;
+		MonoType* element = mono_class_get_type(mono_class_get_element_class(klass));
+		return static_cast<bool>(mono_type_is_reference(element)) == IsReference ? array : nullptr;
+	}
+
+	/* Primitive element classes are deduced from T, anything else must be passed in */
+	static ManagedArray New(size_t length, MonoClass* elementClass = nullptr) {
+		if (!elementClass)
+			elementClass = ManagedPrimitiveClass(ManagedTypeEnumOf<T>());
+		return ManagedArray(elementClass ? NewManagedArray(elementClass, length) : nullptr);
+	}
+
+	MonoArray* RawArray() const {
+		return reinterpret_cast<MonoArray*>(m_ref.Get());
+	}
+
+	explicit operator bool() const {
+		return m_ref.Get() != nullptr;
+	}
+
+	size_t Length() const {
+		return m_length;
+	}
+
+	/* Stable while this view is alive. Don't store references through it, use Set for those */
+	T* Data() {
+		return m_data;
+	}
+	const T* Data() const {
+		return m_data;
+	}
+
+	T* begin() {
+		return m_data;
+	}
+	T* end() {
+		return m_data + m_length;
+	}
+
+	const T& operator[](size_t index) const {
+		return m_data[index];
+	}
+
+	T Get(size_t index) const {
+		return m_data[index];
+	}
+
+	void Set(size_t index, T value) {
+		if constexpr (IsReference)
+			mono_gc_wbarrier_set_arrayref(RawArray(), m_data + index, reinterpret_cast<MonoObject*>(value));
+		else
+			m_data[index] = value;
+	}
+
+	bool CopyFrom(const T* src, size_t count, size_t offset = 0) {
+		if (offset > m_length || count > m_length - offset)
+			return false;
+		if constexpr (IsReference) {
+			for (size_t i = 0; i < count; i++)
+				Set(offset + i, src[i]);
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+			NormalizeBools(src, m_data + offset, count);
+		else
+			memcpy(m_data + offset, src, count * sizeof(T));
+		return true;
+	}
+
+	bool CopyTo(T* dst, size_t count, size_t offset = 0) const {
+		if (offset > m_length || count > m_length - offset)
+			return false;
+		if constexpr (std::is_same_v<T, bool>)
+			NormalizeBools(m_data + offset, dst, count);
+		else
+			memcpy(dst, m_data + offset, count * sizeof(T));
+		return true;
+	}
+
+	/* char[] only. Widens or narrows between Latin-1 bytes and UTF-16 elements */
+	bool CopyFromLatin1(const char* src, size_t count, size_t offset = 0) {
+		static_assert(std::is_same_v<T, char16_t>, "Latin-1 conversion is only available for char arrays");
+		if (offset > m_length || count > m_length - offset)
+			return false;
+		ConvertLatin1ToUtf16(src, m_data + offset, count);
+		return true;
+	}
+
+	bool CopyToLatin1(char* dst, size_t count, size_t offset = 0) const {
+		static_assert(std::is_same_v<T, char16_t>, "Latin-1 conversion is only available for char arrays");
+		if (offset > m_length || count > m_length - offset)
+			return false;
+		ConvertUtf16ToLatin1(m_data + offset, dst, count);
+		return true;
+	}
+};
+
+//==============================================================================================//
+// String marshaling
+//      UTF-8 <-> UTF-16 transcoding with a vectorized ASCII fast path, so strings don't
+//      need mono_string_new or mono_string_to_utf8 and mono_free round trips.
+//      Invalid sequences and lone surrogates are replaced by U+FFFD.
+//==============================================================================================//
+
+/* dst needs room for len units, returns the number written */
+size_t Utf8ToUtf16(const char* src, size_t len, char16_t* dst);
+/* dst needs room for 3 * len bytes, returns the number written */
+size_t Utf16ToUtf8(const char16_t* src, size_t len, char* dst);
+
+/* Characters of a managed string, valid as long as the string is alive and doesn't move */
+inline std::u16string_view StringView(MonoString* str) {
+	if (!str)
+		return {};
+	return std::u16string_view(reinterpret_cast<const char16_t*>(mono_string_chars(str)), mono_string_length(str));
+}
+
+MonoString* NewManagedString(std::string_view utf8);
+std::string ToUtf8(MonoString* str);
+
+//==============================================================================================//
+// ManagedStringCache
+//      Interned managed strings keyed by their native value, rooted by pinned GC handles.
+//      For identifiers and event names passed across over and over.
+//==============================================================================================//
+class ManagedStringCache
+{
+private:
+	struct Entry_t
+	{
+		std::string value;
+		PinnedObjectRef string;
+	};
+	std::unordered_multimap<uint64_t, Entry_t> m_strings; // Keyed by HashString
+
+public:
+	/* Returns the interned managed string equal to str, creating it on first use */
+	MonoString* Get(std::string_view str);
+
+	size_t Size() const {
+		return m_strings.size();
+	};
+
+	/* Releases every handle. Returned strings may be collected afterwards */
+	void Clear() {
+		m_strings.clear();
+	};
 };
 
 //==============================================================================================//
@@ -420,7 +1843,7 @@ class ManagedProperty : public ManagedBase<ManagedProperty>
 private:
 	MonoProperty* m_property;
 	class ManagedClass& m_class;
-	std::string m_name;
+	std::pmr::string m_name;
 	MonoMethod* m_getMethod;
 	MonoMethod* m_setMethod;
 
@@ -436,17 +1859,44 @@ protected:
 	friend class ManagedClass;
 	friend class ManagedMethod;
 	friend class ManagedObject;
+	friend class ManagedAssembly;
 
 public:
 	const MonoProperty* RawProperty() const {
 		return m_property;
 	};
 
+	std::string_view Name() const {
+		return m_name;
+	}
+
 	const ManagedClass& Class() const {
 		return m_class;
 	}
 };
 
+//==============================================================================================//
+// StructFieldBinding_t
+//      One member of a C++ struct bound onto a managed value type, see BindStruct
+//==============================================================================================//
+struct StructFieldBinding_t
+{
+	const char* name; // Managed field name
+	size_t offset;
+	size_t size;
+};
+
+/* Unique address per C++ type, identifies the struct a value type was bound to */
+template <class T> const void* ManagedStructTag() {
+	static const char tag = 0;
+	return &tag;
+}
+
+#define MONO_STRUCT_FIELD(type, member)                                                                                \
+	mono::StructFieldBinding_t {                                                                                       \
+		#member, offsetof(type, member), sizeof(static_cast<type*>(nullptr)->member)                                   \
+	}
+
 //==============================================================================================//
 // ManagedClass
 //      Represents a MonoClass object and stores cached info about it
@@ -454,17 +1904,27 @@ public:
 class ManagedClass : public ManagedBase<ManagedClass>
 {
 private:
-	std::vector<class ManagedMethod*> m_methods;
-	std::vector<class ManagedField*> m_fields;
-	std::vector<class ManagedObject*> m_attributes;
+	std::pmr::vector<class ManagedMethod*> m_methods;
+	std::pmr::vector<class ManagedField*> m_fields;
+	std::pmr::vector<class ManagedObject*> m_attributes;
 	MonoCustomAttrInfo* m_attrInfo;
-	std::vector<class ManagedProperty*> m_properties;
-	std::string m_namespaceName;
-	std::string m_className;
+	std::pmr::vector<class ManagedProperty*> m_properties;
+	ManagedMemberIndex<class ManagedMethod> m_methodIndex;
+	ManagedMemberIndex<class ManagedField> m_fieldIndex;
+	ManagedMemberIndex<class ManagedProperty> m_propertyIndex;
+	std::unordered_map<uint64_t, class ManagedMethod*> m_methodSignatureCache;
+	/* Entry in the assembly's reflection cache, if any. Lets single members be resolved by token
+	 * before the full member lists are populated. Those are kept here, keyed by token */
+	const ReflectionCacheType_t* m_cacheEntry;
+	std::unordered_map<uint32_t, class ManagedMethod*> m_cachedMethods;
+	std::unordered_map<uint32_t, class ManagedField*> m_cachedFields;
+	std::pmr::string m_namespaceName;
+	std::pmr::string m_className;
 	MonoClass* m_class;
 	ManagedAssembly* m_assembly;
 	mono_byte m_numConstructors;
 	mono_byte m_alignment;
+	uint8_t m_populatedParts;
 
 	bool m_populated : 1;
 	bool m_valueClass : 1;
@@ -472,46 +1932,85 @@ private:
 	bool m_enumClass : 1;
 	bool m_nullableClass : 1;
 
-	uint32_t m_size; // Size in bytes
+	uint32_t m_size;	  // Size in bytes
+	uint32_t m_boundSize; // Size of the C++ struct bound with BindStruct, 0 if there's none
+	const void* m_boundType; // ManagedStructTag of that struct, if bound through BindStruct<T>
+	MonoVTable* m_vtable; // Resolved on first use
 
 	friend class ManagedScriptContext;
 	friend class ManagedMethod;
 	friend class ManagedAssembly;
 	friend class ManagedObject;
 
+public:
+	/* Reflection info is materialized in independent parts, so that lazy classes only pay for what they use */
+	enum EReflectionPart : uint8_t
+	{
+		REFLECTION_METHODS = 1 << 0,
+		REFLECTION_FIELDS = 1 << 1,
+		REFLECTION_PROPERTIES = 1 << 2,
+		REFLECTION_ATTRIBUTES = 1 << 3,
+		REFLECTION_LAYOUT = 1 << 4,
+		REFLECTION_ALL = 0x1F,
+	};
+
+	/* True if all of parts (EReflectionPart) have been materialized */
+	bool IsPopulated(uint8_t parts) const {
+		return (m_populatedParts & parts) == parts;
+	};
+
 protected:
 	ManagedClass(ManagedAssembly* assembly, const std::string& ns, const std::string& cls);
 	ManagedClass(ManagedAssembly* assembly, MonoClass* _cls, const std::string& ns, const std::string& cls);
 	~ManagedClass();
 
 	void PopulateReflectionInfo();
+	void PopulateReflectionInfo(uint8_t parts);
+
+	void EnsurePopulated(uint8_t parts) const {
+		if ((m_populatedParts & parts) != parts)
+			const_cast<ManagedClass*>(this)->PopulateReflectionInfo(parts);
+	}
 
 	void InvalidateHandle() override;
 
+	ManagedObject* CreateInstance(ManagedMethod* ctor, bool hasParams, void** params);
+
+	ManagedMethod* FindCachedMethod(std::string_view name, int arity, const ManagedSignatureDesc_t* sig);
+	ManagedField* FindCachedField(std::string_view name);
+
+	MonoObject* BoxBlittable(const void* value, size_t size);
+	bool UnboxBlittable(MonoObject* obj, void* value, size_t size);
+
 public:
 	ManagedClass() = delete;
 	ManagedClass(ManagedClass&& c) = delete;
 	ManagedClass(ManagedClass&) = delete;
 
-	const std::string& NamespaceName() const {
+	std::string_view NamespaceName() const {
 		return m_namespaceName;
 	};
-	const std::string& ClassName() const {
+	std::string_view ClassName() const {
 		return m_className;
 	};
-	const std::vector<class ManagedMethod*>& Methods() const {
+	ManagedRange<class ManagedMethod> Methods() const {
+		EnsurePopulated(REFLECTION_METHODS);
 		return m_methods;
 	};
-	const std::vector<class ManagedField*>& Fields() const {
+	ManagedRange<class ManagedField> Fields() const {
+		EnsurePopulated(REFLECTION_FIELDS);
 		return m_fields;
 	};
-	const std::vector<class ManagedObject*>& Attributes() const {
+	ManagedRange<class ManagedObject> Attributes() const {
+		EnsurePopulated(REFLECTION_ATTRIBUTES);
 		return m_attributes;
 	};
-	const std::vector<class ManagedProperty*>& Properties() const {
+	ManagedRange<class ManagedProperty> Properties() const {
+		EnsurePopulated(REFLECTION_PROPERTIES);
 		return m_properties;
 	};
 	uint32_t DataSize() const {
+		EnsurePopulated(REFLECTION_LAYOUT);
 		return m_size;
 	};
 	bool ValueClass() const {
@@ -527,16 +2026,75 @@ public:
 		return m_nullableClass;
 	};
 	int Alignment() const {
+		EnsurePopulated(REFLECTION_LAYOUT);
 		return m_alignment;
 	};
 
+	MonoClass* RawClass() const {
+		return m_class;
+	};
+
+	ManagedAssembly& Assembly() const {
+		return *m_assembly;
+	};
+
 	mono_byte NumConstructors() const;
 
-	ManagedMethod* FindMethod(const std::string& name);
-	ManagedField* FindField(const std::string& name);
-	ManagedProperty* FindProperty(const std::string& prop);
+	/* Member lookups are hash probes and do not allocate. With several overloads the first
+	 * declared one is returned */
+	ManagedMethod* FindMethod(std::string_view name);
+	ManagedMethod* FindMethod(std::string_view name, int paramCount);
+	ManagedField* FindField(std::string_view name);
+	ManagedProperty* FindProperty(std::string_view prop);
+
+	/* Appends all overloads of name to out, in declaration order. Returns the number found */
+	size_t FindOverloads(std::string_view name, std::vector<ManagedMethod*>& out);
+
+	/* Finds the overload of name matching sig. Hits are cached per signature and verified on reuse */
+	ManagedMethod* FindMethod(std::string_view name, const ManagedSignatureDesc_t& sig);
+	template <class Sig> ManagedMethod* FindMethod(std::string_view name) {
+		return FindMethod(name, ManagedSignature<Sig>::Desc);
+	}
+
+	ManagedObject* CreateInstance(const std::vector<MonoType*>& signature, void** params);
+
+	/* Creates an instance using the constructor matching sig, which must return void */
+	ManagedObject* CreateInstance(const ManagedSignatureDesc_t& sig, void** params);
+	template <class Sig> ManagedObject* CreateInstance(void** params) {
+		return CreateInstance(ManagedSignature<Sig>::Desc, params);
+	}
+
+	/* Prepares the constructor matching Sig, e.g. GetConstructor<void(int32_t, float)>().
+	 * Keep it around, creating objects through it skips the lookup and mono_runtime_invoke */
+	template <class Sig> ManagedConstructor<Sig> GetConstructor();
+
+	/* VTable of the class in the context's domain, resolved once */
+	MonoVTable* VTable();
 
-	ManagedObject* CreateInstance(std::vector<MonoType*> signature, void** params);
+	/* Verifies that a C++ struct of the given size and alignment lays out exactly like this value type,
+	 * every instance field covered once at the same offset and size and none of them holding references,
+	 * nested value types included. On success the pairing is marked blittable.
+	 * Prefer the BindStruct<T> helper, which also records T for Box/Unbox */
+	bool BindStruct(size_t size, size_t alignment, const StructFieldBinding_t* fields, size_t count,
+					const void* tag = nullptr);
+
+	/* Bound with BindStruct to a C++ struct of size bytes */
+	bool IsBlittable(size_t size) const {
+		return m_boundSize && m_boundSize == size;
+	};
+
+	/* Bound with BindStruct<T> */
+	template <class T> bool IsBoundTo() const {
+		return m_boundSize && m_boundType == ManagedStructTag<T>();
+	};
+
+	/* memcpy boxing and unboxing for value types bound to T. Fail if T isn't bound to this class */
+	template <class T> MonoObject* Box(const T& value) {
+		return IsBoundTo<T>() ? BoxBlittable(&value, sizeof(T)) : nullptr;
+	}
+	template <class T> bool Unbox(MonoObject* obj, T& value) {
+		return IsBoundTo<T>() && UnboxBlittable(obj, &value, sizeof(T));
+	}
 
 	bool ImplementsInterface(ManagedClass& interface);
 	bool DerivedFromClass(ManagedClass& cls);
@@ -559,6 +2117,407 @@ public:
 	inline bool IsBool();
 };
 
+//==============================================================================================//
+// ManagedConstructor
+//      Prepared constructor of a class for one signature. Objects are allocated from the
+//      cached vtable and initialized through the constructor's unmanaged thunk, once.
+//==============================================================================================//
+template <class... Args> class ManagedConstructor<void(Args...)>
+{
+public:
+	/* Constructors are bound as instance methods, 'this' being the freshly allocated object */
+	using ThunkSig = void(MonoObject*, Args...);
+
+private:
+	using ThunkT = ManagedThunk<ThunkSig>;
+
+	ManagedClass* m_class;
+	MonoVTable* m_vtable;
+	ThunkT m_thunk;
+
+	friend class ManagedClass;
+
+	ManagedConstructor(ManagedClass* cls, MonoVTable* vtable, ThunkT thunk)
+		: m_class(cls), m_vtable(vtable), m_thunk(thunk) {
+	}
+
+public:
+	ManagedConstructor() : m_class(nullptr), m_vtable(nullptr) {
+	}
+
+	bool Valid() const {
+		return m_vtable && m_thunk.Valid();
+	};
+
+	explicit operator bool() const {
+		return Valid();
+	};
+
+	/* Allocates and constructs an object. If the constructor throws, the exception is stored in
+	 * *exception, or reported through the context if that's null, and nullptr is returned */
+	MonoObject* New(MonoObject** exception, Args... args) const {
+		MonoObject* obj = mono_object_new_specific(m_vtable);
+		if (!obj)
+			return nullptr;
+		MonoObject* exc = nullptr;
+		m_thunk.Invoke(&exc, obj, args...);
+		if (exc) {
+			if (exception)
+				*exception = exc;
+			else
+				m_thunk.Method()->ReportException(exc);
+			return nullptr;
+		}
+		return obj;
+	}
+
+	ManagedObject* Create(Args... args) const {
+		MonoObject* obj = New(nullptr, args...);
+		return obj ? new ManagedObject(obj, *m_class) : nullptr;
+	}
+
+	/* Constructs count objects with the same arguments into out, each rooted by a GC handle so out
+	 * may live anywhere. Stops at the first exception, returns the number created */
+	size_t CreateInstances(size_t count, StrongObjectRef* out, Args... args) const {
+		for (size_t i = 0; i < count; i++) {
+			MonoObject* obj = New(nullptr, args...);
+			if (!obj)
+				return i;
+			out[i] = StrongObjectRef(obj);
+		}
+		return count;
+	}
+
+	size_t CreateInstances(size_t count, std::vector<ManagedObject*>& out, Args... args) const {
+		out.reserve(out.size() + count);
+		for (size_t i = 0; i < count; i++) {
+			MonoObject* obj = New(nullptr, args...);
+			if (!obj)
+				return i;
+			out.push_back(new ManagedObject(obj, *m_class));
+		}
+		return count;
+	}
+};
+
+template <class Sig> ManagedConstructor<Sig> ManagedClass::GetConstructor() {
+	ManagedMethod* ctor = FindMethod(".ctor", ManagedSignature<Sig>::Desc);
+	MonoVTable* vtable = ctor ? VTable() : nullptr;
+	if (!vtable)
+		return ManagedConstructor<Sig>();
+	return ManagedConstructor<Sig>(this, vtable, ctor->template Bind<typename ManagedConstructor<Sig>::ThunkSig>());
+}
+
+/* Binds T onto the managed value type cls, e.g.
+ *	BindStruct<Vector3>(*cls, {MONO_STRUCT_FIELD(Vector3, x), MONO_STRUCT_FIELD(Vector3, y), ...}) */
+template <class T> bool BindStruct(ManagedClass& cls, std::initializer_list<StructFieldBinding_t> fields) {
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable structs can be bound");
+	return cls.BindStruct(sizeof(T), alignof(T), fields.begin(), fields.size(), ManagedStructTag<T>());
+}
+
+//==============================================================================================//
+// ManagedUpdateRegistry
+//      Per-frame callbacks of one parameterless method, e.g. Update, over many objects. Entries
+//      are kept as flat arrays of GC handles, bound thunks and enabled flags, one set of arrays
+//      per priority, so running a frame walks memory linearly and calls straight into the thunks.
+//      Adding and removing are O(1), removal swaps the last entry of its priority into the hole
+//==============================================================================================//
+class ManagedUpdateRegistry
+{
+public:
+	/* Identifies an entry for as long as it's registered. Ids of removed entries are reused */
+	using EntryId = uint32_t;
+	static constexpr EntryId InvalidEntry = 0;
+
+private:
+	using ThunkT = void (*)(MonoObject*, MonoException**);
+
+	struct Bucket_t
+	{
+		std::vector<ManagedObjectHandle> handles;
+		std::vector<MonoObject*> objects; // Only with pinned handles
+		std::vector<ThunkT> thunks;
+		std::vector<uint8_t> enabled;
+		std::vector<EntryId> ids;
+		std::vector<ManagedMethod*> methods; // Only touched to report exceptions
+	};
+
+	struct Location_t
+	{
+		Bucket_t* bucket; // nullptr for free ids
+		uint32_t slot;
+	};
+
+	std::string m_methodName;
+	bool m_pinned;
+	uint32_t m_runDepth; // Nested Run() calls in progress
+	size_t m_size;
+
+	/* Run in ascending priority. Map nodes don't move, so locations can point at them */
+	std::map<int32_t, Bucket_t> m_buckets;
+	std::vector<Location_t> m_locations; // Indexed by EntryId - 1
+	std::vector<EntryId> m_freeIds;
+	std::vector<EntryId> m_pendingRemovals; // Removed while running, erased when the outermost Run() returns
+
+	void Erase(EntryId id);
+
+public:
+	/* pinned keeps the objects pinned, so a frame doesn't need to resolve any handles */
+	explicit ManagedUpdateRegistry(std::string methodName, bool pinned = false);
+	ManagedUpdateRegistry(const ManagedUpdateRegistry&) = delete;
+	~ManagedUpdateRegistry();
+
+	/* Registers obj if its class has a void instance method of that name without parameters.
+	 * The registry holds its own handle, so obj may be deleted. Returns InvalidEntry otherwise */
+	EntryId Add(ManagedObject& obj, int32_t priority = 0);
+	EntryId Add(MonoObject* obj, ManagedClass& cls, int32_t priority = 0);
+
+	/* Safe to call from inside Run(), the entry is disabled right away and erased afterwards */
+	bool Remove(EntryId id);
+
+	/* Fails for entries removed during the current Run() */
+	bool SetEnabled(EntryId id, bool enabled);
+	bool Enabled(EntryId id) const;
+
+	size_t Size() const {
+		return m_size;
+	};
+
+	const std::string& MethodName() const {
+		return m_methodName;
+	};
+
+	/* Not from inside Run() */
+	void Clear();
+
+	/* Calls the method on every enabled entry, lowest priority first.
+	 * Exceptions are handled as in ManagedMethod::InvokeBatch, except that the index of
+	 * collected exceptions is the EntryId. A callee may call Run() again, the nested frame runs
+	 * every enabled entry and removals wait until the outermost Run() returns */
+	ManagedBatchResult_t Run(EBatchExceptionPolicy policy = EBatchExceptionPolicy::SKIP);
+};
+
+//==============================================================================================//
+// ManagedExceptionView
+//      Lazy view of a thrown exception. Message, source, stack trace and ToString are only
+//      fetched and converted when asked for, using property getters cached per exception class.
+//      Passed to exception callbacks by reference, copy out what needs to outlive the callback.
+//==============================================================================================//
+struct ManagedExceptionClassInfo_t
+{
+	bool isException; // Derives from System.Exception
+	MonoMethod* getMessage;
+	MonoMethod* getSource;
+	MonoMethod* getStackTrace;
+	MonoClassField* traceIps; // Native IPs of the throwing frames, when the runtime exposes them
+};
+
+class ManagedExceptionView
+{
+private:
+	enum EField : uint8_t
+	{
+		FIELD_MESSAGE = 1 << 0,
+		FIELD_SOURCE = 1 << 1,
+		FIELD_STACKTRACE = 1 << 2,
+		FIELD_STRING = 1 << 3,
+	};
+
+	MonoObject* m_exception;
+	MonoClass* m_class;
+	ManagedExceptionClassInfo_t m_info; // A copy, see ManagedScriptContext::ExceptionClassInfo
+	uint8_t m_resolved;
+	std::string m_message;
+	std::string m_source;
+	std::string m_stackTrace;
+	std::string m_string;
+
+	const std::string& Resolve(EField field, MonoMethod* getter, std::string& out);
+
+public:
+	ManagedExceptionView(class ManagedScriptContext& ctx, MonoObject* exception);
+	ManagedExceptionView(const ManagedExceptionView&) = delete;
+	ManagedExceptionView(ManagedExceptionView&&) = delete;
+
+	MonoObject* RawException() const {
+		return m_exception;
+	};
+
+	/* False for objects that don't derive from System.Exception. Only the class names are available then */
+	bool IsException() const {
+		return m_info.isException;
+	};
+
+	const char* ClassName() const;
+	const char* Namespace() const;
+
+	const std::string& Message();
+	const std::string& Source();
+	const std::string& StackTrace();
+	const std::string& ToString(); // object.ToString()
+
+	/* Resolves everything into a standalone descriptor */
+	ManagedException_t Descriptor();
+
+	/* Native IP of the frame that threw, 0 if unknown. Read from the exception without building a stack trace */
+	uintptr_t ThrowSite() const;
+
+	/* Identifies exceptions of the same class thrown from the same place */
+	uint64_t Fingerprint() const {
+		return HashCombine(reinterpret_cast<uintptr_t>(m_class), ThrowSite());
+	};
+};
+
+//==============================================================================================//
+// ManagedMPSCQueue
+//      Bounded lock-free queue for any number of producers and a single consumer. Pushing onto
+//      a full queue fails instead of blocking. Capacity is rounded up to a power of two
+//==============================================================================================//
+template <class T> class ManagedMPSCQueue
+{
+private:
+	struct Cell_t
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Cell_t[]> m_cells;
+	size_t m_mask;
+	alignas(64) std::atomic<size_t> m_head; // Next slot to push, shared by the producers
+	alignas(64) size_t m_tail;				// Next slot to pop, consumer only
+
+public:
+	explicit ManagedMPSCQueue(size_t capacity) : m_head(0), m_tail(0) {
+		size_t size = 2;
+		while (size < capacity)
+			size <<= 1;
+		m_cells.reset(new Cell_t[size]);
+		m_mask = size - 1;
+		for (size_t i = 0; i < size; i++)
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	ManagedMPSCQueue(const ManagedMPSCQueue&) = delete;
+	ManagedMPSCQueue& operator=(const ManagedMPSCQueue&) = delete;
+
+	size_t Capacity() const {
+		return m_mask + 1;
+	};
+
+	bool TryPush(T&& value) {
+		size_t pos = m_head.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell_t& cell = m_cells[pos & m_mask];
+			size_t seq = cell.sequence.load(std::memory_order_acquire);
+			intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if (diff == 0) {
+				if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					cell.value = std::move(value);
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false; // Full, the consumer hasn't released this slot yet
+			else
+				pos = m_head.load(std::memory_order_relaxed);
+		}
+	}
+
+	/* Consumer thread only */
+	bool TryPop(T& out) {
+		Cell_t& cell = m_cells[m_tail & m_mask];
+		if (cell.sequence.load(std::memory_order_acquire) != m_tail + 1)
+			return false;
+		out = std::move(cell.value);
+		cell.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+		m_tail++;
+		return true;
+	}
+};
+
+//==============================================================================================//
+// ManagedExceptionReporter
+//      Delivers exception reports to callbacks on its own thread, so a script throwing every
+//      frame costs the game thread a queue push instead of the callbacks' work
+//==============================================================================================//
+struct ManagedExceptionReport_t
+{
+	ManagedException_t exception;
+	std::string assembly;
+	uint64_t fingerprint;
+	uint64_t count;		 // Times this fingerprint was thrown so far
+	uint64_t suppressed; // Throws of this fingerprint that were only counted since the last report
+};
+
+/* Controls how much work ManagedScriptContext::ReportException does for repeated exceptions */
+struct ManagedExceptionPolicy_t
+{
+	/* Occurrences of each fingerprint that are always reported in full */
+	uint32_t describeFirst = 8;
+	/* Past that, full reports are drawn from a budget shared by all fingerprints, refilled at
+	 * this rate. Everything over budget is only counted */
+	float describePerSecond = 4.0f;
+	/* Off by default, every exception is reported in full. Set it to apply the limits above */
+	bool throttle = false;
+	/* Reports queued for the reporter thread. Reports that don't fit are dropped and counted */
+	size_t queueCapacity = 256;
+};
+
+/* Aggregated counts for one fingerprint */
+struct ManagedExceptionStats_t
+{
+	uint64_t fingerprint;
+	std::string klass;
+	std::string ns;
+	uint64_t count;
+	uint64_t described;
+};
+
+class ManagedExceptionReporter
+{
+public:
+	using CallbackT = std::function<void(const ManagedExceptionReport_t&)>;
+
+private:
+	ManagedMPSCQueue<ManagedExceptionReport_t> m_queue;
+	std::vector<CallbackT> m_callbacks;
+	std::mutex m_callbackMutex;
+
+	/* Only the reporter thread and Flush() lock this, producers just notify */
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_idle;
+
+	std::atomic<bool> m_stop;
+	std::atomic<uint64_t> m_posted;
+	std::atomic<uint64_t> m_delivered;
+	std::atomic<uint64_t> m_dropped;
+	std::thread m_thread;
+
+	void Run();
+	void Deliver();
+
+public:
+	explicit ManagedExceptionReporter(size_t capacity);
+	ManagedExceptionReporter(const ManagedExceptionReporter&) = delete;
+	/* Delivers whatever is still queued before joining */
+	~ManagedExceptionReporter();
+
+	void AddCallback(CallbackT callback);
+
+	/* Lock-free. Returns false and counts the report as dropped when the queue is full */
+	bool Post(ManagedExceptionReport_t&& report);
+
+	/* Blocks until every report posted so far was delivered */
+	void Flush();
+
+	uint64_t Dropped() const {
+		return m_dropped.load(std::memory_order_relaxed);
+	};
+};
+
 /* NOTE: this class cannot have a handle pointed at it */
 //==============================================================================================//
 // ManagedScriptContext
@@ -571,6 +2530,8 @@ public:
 	MonoDomain* m_domain;
 	std::string m_baseImage;
 	bool m_initialized = false;
+	bool m_lazyReflection = false;
+	std::string m_reflectionCacheDir;
 
 public:
 	ManagedScriptContext() = delete;
@@ -579,28 +2540,99 @@ public:
 
 	friend class ManagedCompiler;
 	friend class ManagedClass;
+	friend class ManagedAssembly;
 
 	using ExceptionCallbackT =
 		std::function<void(ManagedScriptContext*, ManagedAssembly*, MonoObject*, ManagedException_t)>;
+	/* Gets the exception lazily, nothing is fetched from it unless the callback asks */
+	using ExceptionViewCallbackT = std::function<void(ManagedScriptContext*, ManagedAssembly*, ManagedExceptionView&)>;
 
 protected:
 	std::vector<ExceptionCallbackT> m_callbacks;
+	std::vector<ExceptionViewCallbackT> m_viewCallbacks;
+
+	/* Guards the exception class cache, fingerprints and describe budget, so any thread may report */
+	mutable std::mutex m_exceptionMutex;
+
+	/* Property getters of exception classes seen so far */
+	std::unordered_map<MonoClass*, ManagedExceptionClassInfo_t> m_exceptionClasses;
+
+	friend class ManagedExceptionView;
+	/* By value, entries may be dropped by UnloadAssembly as soon as the lock is released */
+	ManagedExceptionClassInfo_t ExceptionClassInfo(MonoClass* cls);
+
+	struct ExceptionFingerprint_t
+	{
+		/* Copied when first seen, the class may be unloaded before the stats are read */
+		std::string klass;
+		std::string ns;
+		uint64_t count;
+		uint64_t described;
+		uint64_t suppressed; // Since the last full report
+	};
+
+	ManagedExceptionPolicy_t m_exceptionPolicy;
+	std::unordered_map<uint64_t, ExceptionFingerprint_t> m_exceptionFingerprints;
+	/* Token bucket for full reports of fingerprints past describeFirst */
+	float m_describeBudget;
+	std::chrono::steady_clock::time_point m_describeRefill;
+	/* Created with the first report callback */
+	std::unique_ptr<ManagedExceptionReporter> m_reporter;
+
+	/* Call with m_exceptionMutex held */
+	bool ShouldDescribe(ExceptionFingerprint_t& fingerprint);
+
+	struct MissedType_t
+	{
+		std::string ns;
+		std::string cls;
+	};
+
+	/* Results of FindClass(ns, cls) across all loaded assemblies, keyed by HashTypeName */
+	std::unordered_map<uint64_t, ManagedClass*> m_typeIndex;
+	/* Names that FindClass(ns, cls) failed to resolve. Cleared whenever the set of assemblies changes */
+	std::unordered_map<uint64_t, MissedType_t> m_missedTypes;
+
+	ManagedStringCache m_internedStrings;
 
 	friend class ManagedScriptSystem;
 
-	explicit ManagedScriptContext(const std::string& baseImage);
+	void InvalidateTypeIndex(ManagedAssembly* assembly);
+
+	explicit ManagedScriptContext(const std::string& baseImage, const struct ManagedScriptSystemSettings_t& settings);
 	~ManagedScriptContext();
 
 	void PopulateReflectionInfo();
 
+	ManagedAssembly* LoadAssemblyFromData(const char* name, const char* data, size_t size);
+	void AddAssembly(ManagedAssembly* assembly);
+
 public:
 	bool LoadAssembly(const char* path);
 
+	/* Loads an assembly image straight from a caller-owned buffer, without copying it.
+	 * The buffer must stay valid and unmodified for as long as the assembly is loaded.
+	 * name stands in for the path, e.g. for UnloadAssembly and FindAssembly */
+	bool LoadAssemblyFromMemory(const char* name, const void* data, size_t size);
+
+	/* Maps path read-only and loads the image from the mapping, so every context and
+	 * process loading the same file shares its page cache pages */
+	bool LoadAssemblyMapped(const char* path);
+
+	/* Loads the named assembly out of a bundle. Shares the image with references resolved from it */
+	bool LoadAssemblyFromBundle(ManagedScriptBundle& bundle, const char* name);
+
+	/* Opens the assemblies and populates their reflection info on a pool of mono attached threads,
+	 * then publishes them all at once, in order. threads = 0 uses one per core.
+	 * Returns the number of assemblies loaded */
+	size_t LoadAssemblies(const std::vector<std::string>& paths, unsigned int threads = 0);
+
 	bool UnloadAssembly(const std::string& name);
 
 	bool Init();
 
 	/* Performs a class search in all loaded assemblies */
+	/* Hits and misses are both cached, so repeated lookups are a single hash probe */
 	/* If you have the assembly name, please use the alternative version of this
 	 * function */
 	ManagedClass* FindClass(const std::string& ns, const std::string& cls);
@@ -609,29 +2641,170 @@ public:
 
 	/* Returns a pointer to a raw MonoClass object corresponding to the
 	 * specified class */
-	/* This doesn't cache the class in a lookup table. You'll need to save the
-	 * class yourself */
+	/* Results are cached process-wide and common corlib types are pre-seeded.
+	 * Misses are forgotten whenever mono loads another assembly */
 	MonoClass* FindSystemClass(const std::string& ns, const std::string& cls);
 
 	ManagedAssembly* FindAssembly(const std::string& path);
 
 	ManagedException_t GetExceptionDescriptor(MonoObject* exception);
 
+	/* Managed string for str, created once and kept alive for the lifetime of the context */
+	MonoString* InternString(std::string_view str) {
+		return m_internedStrings.Get(str);
+	};
+
 	/* Clears all reflection info stored in each assembly description */
 	/* WARNING: this will invalidate your handles! */
 	void ClearReflectionInfo();
 
 	bool ValidateAgainstWhitelist(const std::vector<std::string>& whitelist);
 
+	/* May be called from any mono attached thread. Callbacks run on the reporting thread */
 	void ReportException(MonoObject& obj, ManagedAssembly& ass);
 
+	/* Callbacks taking a full ManagedException_t force every exception to be described up front,
+	 * prefer RegisterExceptionViewCallback */
 	void RegisterExceptionCallback(ExceptionCallbackT callback) {
 		m_callbacks.push_back(callback);
 	}
 
+	void RegisterExceptionViewCallback(ExceptionViewCallbackT callback) {
+		m_viewCallbacks.push_back(std::move(callback));
+	}
+
+	/* Called on the reporter thread with a copy of each full report, never from inside mono */
+	void RegisterExceptionReportCallback(ManagedExceptionReporter::CallbackT callback);
+
+	/* Only applies to exceptions reported afterwards. The queue capacity is fixed once the reporter started */
+	void SetExceptionPolicy(const ManagedExceptionPolicy_t& policy);
+
+	const ManagedExceptionPolicy_t& ExceptionPolicy() const {
+		return m_exceptionPolicy;
+	};
+
+	std::vector<ManagedExceptionStats_t> ExceptionStats() const;
+
+	void ResetExceptionStats() {
+		std::lock_guard<std::mutex> lock(m_exceptionMutex);
+		m_exceptionFingerprints.clear();
+	};
+
+	/* Reports dropped because the reporter queue was full */
+	uint64_t DroppedExceptionReports() const {
+		return m_reporter ? m_reporter->Dropped() : 0;
+	};
+
+	/* Waits until the reporter thread delivered every queued report */
+	void FlushExceptionReports() {
+		if (m_reporter)
+			m_reporter->Flush();
+	};
+
 	MonoDomain* RawDomain() const {
 		return m_domain;
 	};
+
+	bool LazyReflection() const {
+		return m_lazyReflection;
+	};
+};
+
+//==============================================================================================//
+// ManagedDelegate
+//      Typed handle to a managed delegate. The unmanaged thunk of the delegate type's Invoke is
+//      resolved once per type and shared process-wide, calls go straight through it. Invoke
+//      walks multicast invocation lists itself, so those need no extra resolving either.
+//==============================================================================================//
+
+/* Unmanaged thunk of delegateClass's Invoke method, resolved once per delegate type.
+ * The cache is dropped whenever a context closes an image, since its classes may be freed.
+ * Null unless Invoke matches sig, checked type by type as ManagedMethod::MatchSignature does */
+void* DelegateInvokeThunk(MonoClass* delegateClass, const ManagedSignatureDesc_t& sig);
+
+template <class Sig, EManagedObjectHandleType Type = EManagedObjectHandleType::HANDLE> class ManagedDelegate;
+
+template <class R, class... Args, EManagedObjectHandleType Type> class ManagedDelegate<R(Args...), Type>
+{
+private:
+	using FuncT = R (*)(MonoObject*, Args..., MonoException**);
+
+	ObjectRef<Type> m_delegate;
+	FuncT m_func;
+	ManagedAssembly* m_owner;
+
+public:
+	ManagedDelegate() : m_func(nullptr), m_owner(nullptr) {
+	}
+
+	/* Invalid unless delegate is a delegate whose Invoke matches Sig.
+	 * Exceptions thrown through operator() are reported as coming from owner, if there is one */
+	explicit ManagedDelegate(MonoObject* delegate, ManagedAssembly* owner = nullptr)
+		: m_func(nullptr), m_owner(owner) {
+		if (!delegate)
+			return;
+		void* thunk = DelegateInvokeThunk(mono_object_get_class(delegate), ManagedSignature<R(Args...)>::Desc);
+		if (!thunk)
+			return;
+		m_delegate = ObjectRef<Type>(delegate);
+		m_func = reinterpret_cast<FuncT>(thunk);
+	}
+
+	bool Valid() const {
+		return m_func != nullptr;
+	};
+
+	explicit operator bool() const {
+		return Valid();
+	};
+
+	MonoObject* RawDelegate() const {
+		return m_delegate.Get();
+	};
+
+	void Reset() {
+		m_delegate.Reset();
+		m_func = nullptr;
+	}
+
+	/* Calls the delegate. Exceptions are reported through the owner's context,
+	 * in which case a value-initialized R is returned */
+	R operator()(Args... args) const {
+		MonoObject* exc = nullptr;
+		if constexpr (std::is_void_v<R>) {
+			Invoke(&exc, args...);
+			if (exc && m_owner)
+				m_owner->Context().ReportException(*exc, *m_owner);
+		} else {
+			R ret = Invoke(&exc, args...);
+			if (exc && m_owner)
+				m_owner->Context().ReportException(*exc, *m_owner);
+			return ret;
+		}
+	}
+
+	/* Calls the delegate, storing any raised exception in *exception instead of reporting it.
+	 * An invalid or collected delegate returns a value-initialized R */
+	R Invoke(MonoObject** exception, Args... args) const {
+		*exception = nullptr;
+		MonoObject* delegate = m_func ? m_delegate.Get() : nullptr;
+		if (!delegate) {
+			if constexpr (std::is_void_v<R>)
+				return;
+			else
+				return R{};
+		}
+
+		MonoException* exc = nullptr;
+		if constexpr (std::is_void_v<R>) {
+			m_func(delegate, args..., &exc);
+			*exception = reinterpret_cast<MonoObject*>(exc);
+		} else {
+			R ret = m_func(delegate, args..., &exc);
+			*exception = reinterpret_cast<MonoObject*>(exc);
+			return exc ? R{} : ret;
+		}
+	}
 };
 
 //==============================================================================================//
@@ -655,6 +2828,14 @@ struct ManagedScriptSystemSettings_t
 	void (*_free)(void* mem);
 	void* (*_calloc)(size_t count, size_t size);
 
+	/* If true, assemblies don't wrap every type on load, and classes only populate their
+	 * methods, fields, properties, attributes and layout when first accessed */
+	bool lazyReflection;
+
+	/* Directory for persistent reflection caches, one file per image GUID. Written on first
+	 * load of an image and memory-mapped afterwards. Disabled if null */
+	const char* reflectionCacheDir;
+
 	ManagedScriptSystemSettings_t() {
 		_malloc = nullptr;
 		_realloc = nullptr;
@@ -663,6 +2844,8 @@ struct ManagedScriptSystemSettings_t
 		configIsFile = true;
 		configData = "";
 		scriptSystemDomainName = "";
+		lazyReflection = false;
+		reflectionCacheDir = nullptr;
 	}
 };
 
@@ -706,6 +2889,11 @@ private:
 	bool m_debugEnabled;
 	ManagedProfilingSettings_t m_profilingSettings;
 
+	std::vector<std::unique_ptr<ManagedScriptBundle>> m_bundles;
+	std::mutex m_bundleMutex;
+
+	static MonoAssembly* BundlePreloadHook(MonoAssemblyName* name, char** assembliesPath, void* userData);
+
 public:
 	explicit ManagedScriptSystem(ManagedScriptSystemSettings_t settings);
 	~ManagedScriptSystem();
@@ -716,6 +2904,14 @@ public:
 	ManagedScriptSystem() = delete;
 
 	ManagedScriptContext* CreateContext(const char* image);
+	/* Same, with the lazyReflection setting overridden for this context */
+	ManagedScriptContext* CreateContext(const char* image, bool lazyReflection);
+	/* Same, with the reflectionCacheDir setting overridden too. nullptr disables the cache */
+	ManagedScriptContext* CreateContext(const char* image, bool lazyReflection, const char* reflectionCacheDir);
+
+	/* Maps a script bundle and registers it, so assembly references are resolved from it
+	 * before mono searches the disk. The bundle lives as long as the script system */
+	ManagedScriptBundle* LoadBundle(const char* path);
 
 	void DestroyContext(ManagedScriptContext* ctx);
 
@@ -1,4 +1,5 @@
 using System;
+using System.Runtime.CompilerServices;
 
 namespace WrapperTests
 {
@@ -9,6 +10,24 @@ namespace WrapperTests
 		public int integer;
 	}
 	
+	public struct Vec3
+	{
+		public float x;
+		public float y;
+		public float z;
+	}
+
+	public struct NamedTag
+	{
+		public string name;
+	}
+
+	public struct TaggedValue
+	{
+		public int id;
+		public NamedTag tag;
+	}
+
 	public class WrapperTestClass
 	{
 		public WrapperTestClass()
@@ -22,6 +41,21 @@ namespace WrapperTests
 			return true;
 		}
 
+		public static int Add(int a, int b)
+		{
+			return a + b;
+		}
+
+		public static float Add(float a, float b)
+		{
+			return a + b;
+		}
+
+		public static float SumVec3(Vec3 v)
+		{
+			return v.x + v.y + v.z;
+		}
+
 		public bool Test2()
 		{
 			Console.WriteLine("Test2 method called");
@@ -42,4 +76,125 @@ namespace WrapperTests
 			throw new Exception("AAAAAAAAAAAAAA");
 		}
 	}
+
+	public class BatchTarget
+	{
+		public int ticks;
+		public bool broken;
+
+		public void Tick()
+		{
+			if (broken)
+				throw new InvalidOperationException("Broken tick");
+			ticks++;
+		}
+
+		public void Advance(int amount)
+		{
+			ticks += amount;
+		}
+	}
+
+	public class RegistryRemover
+	{
+		public int ticks;
+
+		/* Calls back into the native update registry while it's running */
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern void RemoveFromRegistry(RegistryRemover self);
+
+		public void Tick()
+		{
+			ticks++;
+			RemoveFromRegistry(this);
+		}
+	}
+
+	public interface IBehaviour
+	{
+		int Think(int input);
+	}
+
+	public class IdleBehaviour : IBehaviour
+	{
+		public int Think(int input)
+		{
+			return input;
+		}
+	}
+
+	public class ChaseBehaviour : IBehaviour
+	{
+		public virtual int Think(int input)
+		{
+			return input * 2;
+		}
+	}
+
+	public class FleeBehaviour : ChaseBehaviour
+	{
+		public override int Think(int input)
+		{
+			return -input;
+		}
+	}
+
+	public class PatrolBehaviour : IBehaviour
+	{
+		public int Think(int input)
+		{
+			return input + 1;
+		}
+	}
+
+	public class AmbushBehaviour : FleeBehaviour
+	{
+		public override int Think(int input)
+		{
+			return input * input;
+		}
+	}
+
+	public static class DelegateSource
+	{
+		public static int total;
+
+		public static Func<int, int> MakeScaler(int factor)
+		{
+			return x => x * factor;
+		}
+
+		public static Action<int> MakeMulticast()
+		{
+			Action<int> action = x => total += x;
+			action += x => total += x * 10;
+			return action;
+		}
+
+		public static Action<TestClass> MakeClassAction()
+		{
+			return c => total += c.integer;
+		}
+
+		public static int Total()
+		{
+			return total;
+		}
+	}
+
+	public class StaticData
+	{
+		public static float gravity;
+		public static string motd;
+		public static StaticData instance;
+
+		public int id = 7;
+
+		static StaticData()
+		{
+			gravity = 9.8f;
+			motd = "hello";
+			instance = new StaticData();
+		}
+	}
 }
\ No newline at end of file
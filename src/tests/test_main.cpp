@@ -8,12 +8,15 @@
 #include <mono/metadata/mono-config.h>
 #include <mono/metadata/mono-debug.h>
 #include <mono/metadata/reflection.h>
+#include <mono/metadata/threads.h>
 #include <signal.h>
+#include <atomic>
 
 #include <list>
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -40,8 +43,44 @@ static void RunBasicTest(TestContext_t&);
 static void RunSimpleReturnTest(TestContext_t&);
 static void RunObjectTest(TestContext_t&);
 static void RunComplexObjectTest(TestContext_t&);
+static void RunThunkTest(TestContext_t&);
+static void RunSignatureTest(TestContext_t&);
+static void RunMemberIndexTest(TestContext_t&);
+static void RunClassLookupTest(TestContext_t&);
+static void RunLazyReflectionTest(TestContext_t&);
+static void RunReflectionCacheTest(TestContext_t&);
+static void RunMemoryLoadTest(TestContext_t&);
+static void RunBundleTest(TestContext_t&);
+static void RunParallelLoadTest(TestContext_t&);
+static void RunObjectRefTest(TestContext_t&);
+static void RunFieldAccessorTest(TestContext_t&);
+static void RunStructBindingTest(TestContext_t&);
+static void RunArrayTest(TestContext_t&);
+static void RunStringTest(TestContext_t&);
+static void RunConstructorTest(TestContext_t&);
+static void RunExceptionViewTest(TestContext_t&);
+static void RunExceptionStormTest(TestContext_t&);
+static void RunBatchInvokeTest(TestContext_t&);
+static void RunUpdateRegistryTest(TestContext_t&);
+static void RunVirtualCallSiteTest(TestContext_t&);
+static void RunDelegateTest(TestContext_t&);
+static void RunStaticFieldTest(TestContext_t&);
+static void RunReflectionLifetimeTest(TestContext_t&);
 static void LoadTestDLL(TestContext_t&);
 
+/* Full path of a runtime library assembly, for tests that need an assembly no other test loaded */
+static std::string RuntimeAssemblyPath(const char* file) {
+	const char* dir = getenv("MONO_LIB_PATH");
+	return std::string(dir ? dir : mono_assembly_getrootdir()) + "/" + file;
+}
+
+/* Fresh directory under TMPDIR for files a test writes, the test removes it when done */
+static std::string MakeTempDir() {
+	const char* tmp = getenv("TMPDIR");
+	std::string dir = std::string(tmp && *tmp ? tmp : "/tmp") + "/monowrapper-XXXXXX";
+	return mkdtemp(&dir[0]) ? dir : std::string();
+}
+
 int main(int argc, char** argv) {
 	char* monoLibPath = nullptr;
 	if (!(monoLibPath = getenv("MONO_LIB_PATH")))
@@ -79,6 +118,29 @@ int main(int argc, char** argv) {
 	RunSimpleReturnTest(context);
 	RunObjectTest(context);
 	RunComplexObjectTest(context);
+	RunThunkTest(context);
+	RunSignatureTest(context);
+	RunMemberIndexTest(context);
+	RunClassLookupTest(context);
+	RunLazyReflectionTest(context);
+	RunReflectionCacheTest(context);
+	RunMemoryLoadTest(context);
+	RunBundleTest(context);
+	RunParallelLoadTest(context);
+	RunObjectRefTest(context);
+	RunFieldAccessorTest(context);
+	RunStructBindingTest(context);
+	RunArrayTest(context);
+	RunStringTest(context);
+	RunConstructorTest(context);
+	RunExceptionViewTest(context);
+	RunExceptionStormTest(context);
+	RunBatchInvokeTest(context);
+	RunUpdateRegistryTest(context);
+	RunVirtualCallSiteTest(context);
+	RunDelegateTest(context);
+	RunStaticFieldTest(context);
+	RunReflectionLifetimeTest(context);
 }
 
 static void LoadTestDLL(TestContext_t& context) {
@@ -149,3 +211,1153 @@ static void RunObjectTest(TestContext_t& context) {
 
 static void RunComplexObjectTest(TestContext_t& context) {
 }
+
+static void RunThunkTest(TestContext_t& context) {
+	const char* curTest = "WrapperTest.WrapperTestClass.Add";
+	ManagedMethod* method = context.wrapperTestClass->FindMethod("Add");
+	if (!method) {
+		REPORT_FAIL("Failed to find %s", curTest);
+		return;
+	}
+
+	auto badThunk = method->Bind<int32_t(int32_t)>();
+	if (badThunk)
+		REPORT_FAIL("%s bound with the wrong arity", curTest);
+	else
+		REPORT_PASS("%s arity mismatch rejected", curTest);
+
+	if (method->Bind<double(float, float)>() || method->Bind<int32_t(int32_t, MonoString*)>())
+		REPORT_FAIL("%s bound with mismatched types", curTest);
+	else
+		REPORT_PASS("%s type mismatch rejected", curTest);
+
+	auto thunk = method->Bind<int32_t(int32_t, int32_t)>();
+	if (!thunk) {
+		REPORT_FAIL("%s thunk bind failed", curTest);
+		return;
+	}
+
+	MonoObject* exc = nullptr;
+	int32_t ret = thunk.Invoke(&exc, 40, 2);
+	if (exc)
+		REPORT_FAIL("%s thunk raised exception", curTest);
+	else if (ret != 42)
+		REPORT_FAIL("%s thunk returned %d", curTest, ret);
+	else
+		REPORT_PASS("%s thunk invoke", curTest);
+}
+
+static void RunSignatureTest(TestContext_t& context) {
+	const char* curTest = "WrapperTest.WrapperTestClass signature lookup";
+	ManagedClass* cls = context.wrapperTestClass;
+
+	ManagedMethod* add = cls->FindMethod<int32_t(int32_t, int32_t)>("Add");
+	if (!add || add != cls->FindMethod<int32_t(int32_t, int32_t)>("Add"))
+		REPORT_FAIL("%s: Add(int, int) not found or not cached", curTest);
+	else
+		REPORT_PASS("%s: Add(int, int)", curTest);
+
+	if (cls->FindMethod<int32_t(float, int32_t)>("Add"))
+		REPORT_FAIL("%s: Add(float, int) matched", curTest);
+	else
+		REPORT_PASS("%s: Add(float, int) rejected", curTest);
+
+	if (!cls->FindMethod<MonoObject*(MonoString*, bool, int32_t)>("NonTrivialTypeTest"))
+		REPORT_FAIL("%s: NonTrivialTypeTest(string, bool, int) not found", curTest);
+	else
+		REPORT_PASS("%s: NonTrivialTypeTest(string, bool, int)", curTest);
+}
+
+static void RunMemberIndexTest(TestContext_t& context) {
+	const char* curTest = "WrapperTests member index";
+	std::vector<ManagedMethod*> overloads;
+	if (context.wrapperTestClass->FindOverloads("Add", overloads) != 2)
+		REPORT_FAIL("%s: expected 2 overloads of Add, got %zu", curTest, overloads.size());
+	else
+		REPORT_PASS("%s: Add overloads", curTest);
+
+	if (!context.wrapperTestClass->FindMethod<float(float, float)>("Add"))
+		REPORT_FAIL("%s: Add(float, float) not found", curTest);
+	else
+		REPORT_PASS("%s: Add(float, float)", curTest);
+
+	context.testClass = context.scriptContext->FindClass("WrapperTests", "TestClass");
+	if (!context.testClass) {
+		REPORT_FAIL("Failed to find WrapperTests.TestClass");
+		return;
+	}
+
+	if (!context.testClass->FindField("integer") || context.testClass->FindField("nonexistent"))
+		REPORT_FAIL("%s: field lookup", curTest);
+	else
+		REPORT_PASS("%s: field lookup", curTest);
+
+	/* Enough members to grow the table several times and wrap probe chains around its end */
+	struct TestMember_t
+	{
+		std::string name;
+		int order;
+		const std::string& Name() const {
+			return name;
+		}
+	};
+	std::vector<TestMember_t> members;
+	for (int i = 0; i < 600; i++)
+		members.push_back({"member" + std::to_string(i / 3), i % 3});
+	ManagedMemberIndex<TestMember_t> index;
+	for (auto& m : members)
+		index.Insert(&m, m.name);
+	bool ordered = index.Size() == members.size();
+	for (int i = 0; i < 200; i++) {
+		int expected = 0;
+		index.ForEach("member" + std::to_string(i), ManagedMemberIndex<TestMember_t>::AnyArity, [&](TestMember_t* m) {
+			ordered &= m->order == expected++;
+			return true;
+		});
+		ordered &= expected == 3;
+	}
+	if (!ordered)
+		REPORT_FAIL("%s: declaration order after growing", curTest);
+	else
+		REPORT_PASS("%s: declaration order after growing", curTest);
+}
+
+static void RunClassLookupTest(TestContext_t& context) {
+	const char* curTest = "WrapperTests class lookup";
+	ManagedScriptContext* ctx = context.scriptContext;
+
+	if (ctx->FindClass("WrapperTests", "WrapperTestClass") != context.wrapperTestClass)
+		REPORT_FAIL("%s: repeated lookup returned a different class", curTest);
+	else
+		REPORT_PASS("%s: repeated lookup", curTest);
+
+	/* Second probe is served from the negative cache */
+	if (ctx->FindClass("WrapperTests", "DoesNotExist") || ctx->FindClass("WrapperTests", "DoesNotExist"))
+		REPORT_FAIL("%s: missing class was found", curTest);
+	else
+		REPORT_PASS("%s: missing class", curTest);
+
+	/* Seeded corlib types, then a hit on a type that had to be walked for */
+	MonoClass* list = ctx->FindSystemClass("System.Collections.Generic", "List`1");
+	MonoClass* console = ctx->FindSystemClass("System", "Console");
+	if (ctx->FindSystemClass("System", "Object") != mono_get_object_class() || !list ||
+		ctx->FindSystemClass("System.Collections.Generic", "List`1") != list || !console ||
+		ctx->FindSystemClass("System", "Console") != console)
+		REPORT_FAIL("%s: system class seeding and hits", curTest);
+	else
+		REPORT_PASS("%s: system class seeding and hits", curTest);
+
+	/* A cached miss is retried once another assembly loads */
+	const char* bagNs = "System.Collections.Concurrent";
+	MonoClass* bag = ctx->FindSystemClass(bagNs, "ConcurrentBag`1");
+	if (!bag) {
+		mono_assembly_load_with_partial_name(bagNs, nullptr);
+		bag = ctx->FindSystemClass(bagNs, "ConcurrentBag`1");
+	}
+	if (!bag)
+		REPORT_FAIL("%s: system class miss invalidated by an assembly load", curTest);
+	else
+		REPORT_PASS("%s: system class miss invalidated by an assembly load", curTest);
+
+	/* Cached lookups from several threads at once */
+	std::atomic<int> wrong {0};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([&] {
+			for (int i = 0; i < 1000; i++) {
+				if (ctx->FindSystemClass("System", "String") != mono_get_string_class())
+					wrong++;
+			}
+		});
+	}
+	for (auto& t : threads)
+		t.join();
+	if (wrong)
+		REPORT_FAIL("%s: concurrent system class lookups", curTest);
+	else
+		REPORT_PASS("%s: concurrent system class lookups", curTest);
+}
+
+static void RunLazyReflectionTest(TestContext_t& context) {
+	const char* curTest = "Lazy reflection";
+	ManagedScriptContext* ctx = context.scriptSystem->CreateContext("test1.dll", true);
+	if (!ctx || !ctx->LazyReflection()) {
+		REPORT_FAIL("%s: failed to create a lazy context", curTest);
+		return;
+	}
+
+	using Part = ManagedClass::EReflectionPart;
+	ManagedClass* cls = ctx->FindClass("WrapperTests", "TestClass");
+	if (!cls || cls->IsPopulated(Part::REFLECTION_METHODS) || cls->IsPopulated(Part::REFLECTION_FIELDS) ||
+		cls->IsPopulated(Part::REFLECTION_PROPERTIES))
+		REPORT_FAIL("%s: class populated on lookup", curTest);
+	else
+		REPORT_PASS("%s: nothing populated on lookup", curTest);
+
+	/* Each part is only materialized by the first access that needs it */
+	bool field = cls && cls->FindField("integer") && cls->IsPopulated(Part::REFLECTION_FIELDS) &&
+				 !cls->IsPopulated(Part::REFLECTION_METHODS);
+	bool method = field && cls->FindMethod(".ctor") && cls->IsPopulated(Part::REFLECTION_METHODS) &&
+				  !cls->IsPopulated(Part::REFLECTION_PROPERTIES);
+	bool property = method && !cls->FindProperty("nonexistent") && cls->IsPopulated(Part::REFLECTION_PROPERTIES);
+	if (!field || !method || !property)
+		REPORT_FAIL("%s: fields %d, methods %d, properties %d", curTest, field, method, property);
+	else
+		REPORT_PASS("%s: populated on first access", curTest);
+
+	/* Not destroyed, contexts share the domain and destroying one closes test1.dll's image under the main context */
+}
+
+static void RunReflectionCacheTest(TestContext_t& context) {
+	const char* curTest = "WrapperTests reflection cache";
+	MonoImage* image = mono_class_get_image(context.wrapperTestClass->RawClass());
+	std::string dir = MakeTempDir();
+	if (dir.empty()) {
+		REPORT_FAIL("%s: failed to create a temp dir", curTest);
+		return;
+	}
+	std::string path = ManagedReflectionCache::PathFor(dir, image);
+
+	ManagedReflectionCache cache;
+	if (!ManagedReflectionCache::Write(path, image) || !cache.Open(path, image)) {
+		REPORT_FAIL("%s: failed to write or map %s", curTest, path.c_str());
+		return;
+	}
+	REPORT_PASS("%s: write and map", curTest);
+
+	/* Writers racing on one path each write their own temp file, so none fails and the result is whole */
+	std::atomic<int> written{0};
+	std::vector<std::thread> writers;
+	for (int t = 0; t < 4; t++) {
+		writers.emplace_back([&]() {
+			MonoThread* thread = mono_thread_attach(context.scriptContext->RawDomain());
+			written += ManagedReflectionCache::Write(path, image);
+			mono_thread_detach(thread);
+		});
+	}
+	for (auto& t : writers)
+		t.join();
+	ManagedReflectionCache rewritten;
+	if (written != 4 || !rewritten.Open(path, image) || !rewritten.FindType("WrapperTests", "WrapperTestClass"))
+		REPORT_FAIL("%s: concurrent writers", curTest);
+	else
+		REPORT_PASS("%s: concurrent writers", curTest);
+
+	const ReflectionCacheType_t* type = cache.FindType("WrapperTests", "WrapperTestClass");
+	if (!type || cache.FindType("WrapperTests", "DoesNotExist"))
+		REPORT_FAIL("%s: type lookup", curTest);
+	else
+		REPORT_PASS("%s: type lookup", curTest);
+
+	int overloads = 0;
+	if (type) {
+		cache.ForEachMember(*type, CACHE_MEMBER_METHOD, "Add", [&](const ReflectionCacheMember_t& m) {
+			overloads += m.arity == 2 && m.signatureHash == ManagedSignature<int32_t(int32_t, int32_t)>::Desc.canonicalHash;
+			return true;
+		});
+	}
+	if (overloads != 1)
+		REPORT_FAIL("%s: expected one Add(int, int) entry, got %d", curTest, overloads);
+	else
+		REPORT_PASS("%s: member signatures", curTest);
+
+	cache.Close();
+	remove(path.c_str());
+
+	/* An eager context writes the cache on first load and wraps its types from it */
+	using Part = ManagedClass::EReflectionPart;
+	ManagedScriptContext* eager = context.scriptSystem->CreateContext("test1.dll", false, dir.c_str());
+	ManagedAssembly* ass = eager ? eager->FindAssembly("test1.dll") : nullptr;
+	ManagedClass* cls = eager ? eager->FindClass("WrapperTests", "WrapperTestClass") : nullptr;
+	if (!ass || !ass->ReflectionCache().Valid() || access(path.c_str(), R_OK) != 0 || !cls ||
+		!cls->IsPopulated(Part::REFLECTION_METHODS))
+		REPORT_FAIL("%s: eager context did not populate through %s", curTest, path.c_str());
+	else
+		REPORT_PASS("%s: eager context", curTest);
+
+	/* A lazy context maps the existing file and resolves single members by token */
+	ManagedScriptContext* lazy = context.scriptSystem->CreateContext("test1.dll", true, dir.c_str());
+	ass = lazy ? lazy->FindAssembly("test1.dll") : nullptr;
+	cls = lazy ? lazy->FindClass("WrapperTests", "WrapperTestClass") : nullptr;
+	if (!ass || !ass->ReflectionCache().Valid() || !cls || !cls->FindMethod("Add") ||
+		cls->IsPopulated(Part::REFLECTION_METHODS))
+		REPORT_FAIL("%s: lazy context did not resolve through the cache", curTest);
+	else
+		REPORT_PASS("%s: lazy context", curTest);
+
+	/* Contexts not destroyed, they share test1.dll's image with the main context. The mappings outlive the unlink */
+	remove(path.c_str());
+	rmdir(dir.c_str());
+}
+
+static void RunMemoryLoadTest(TestContext_t& context) {
+	const char* curTest = "In-memory assembly loading";
+	ManagedScriptContext* ctx = context.scriptContext;
+	size_t loaded = ctx->m_loadedAssemblies.size();
+
+	static const char garbage[256] = "MZ not really an image";
+	if (ctx->LoadAssemblyFromMemory("garbage.dll", garbage, sizeof(garbage)) ||
+		ctx->LoadAssemblyMapped("/nonexistent/path.dll") || ctx->m_loadedAssemblies.size() != loaded)
+		REPORT_FAIL("%s: invalid images were loaded", curTest);
+	else
+		REPORT_PASS("%s: invalid images rejected", curTest);
+
+	/* Separate context, so the extra copies of test1.dll don't shadow anything the other tests look up */
+	ctx = context.scriptSystem->CreateContext("test1.dll");
+	if (!ctx) {
+		REPORT_FAIL("%s: failed to create a context", curTest);
+		return;
+	}
+
+	/* Must stay valid for as long as the assembly is loaded, which is the rest of the run */
+	static std::vector<char> image;
+	FILE* fp = fopen("test1.dll", "rb");
+	if (fp) {
+		fseek(fp, 0, SEEK_END);
+		image.resize(ftell(fp));
+		fseek(fp, 0, SEEK_SET);
+		if (fread(image.data(), 1, image.size(), fp) != image.size())
+			image.clear();
+		fclose(fp);
+	}
+
+	/* Each load opens its own image, so the class resolved from it is distinct from test1.dll's */
+	auto resolve = [&](const char* name) -> ManagedClass* {
+		ManagedAssembly* ass = ctx->FindAssembly(name);
+		ManagedClass* cls = ass ? ctx->FindClass(*ass, "WrapperTests", "TestClass") : nullptr;
+		return cls && cls->RawClass() != context.testClass->RawClass() ? cls : nullptr;
+	};
+
+	if (image.empty() || !ctx->LoadAssemblyFromMemory("test1-memory.dll", image.data(), image.size()) ||
+		!resolve("test1-memory.dll"))
+		REPORT_FAIL("%s: failed to load test1.dll from memory", curTest);
+	else
+		REPORT_PASS("%s: load from memory", curTest);
+
+	/* Spelled differently so FindAssembly doesn't return the context's base image */
+	if (!ctx->LoadAssemblyMapped("./test1.dll") || !resolve("./test1.dll"))
+		REPORT_FAIL("%s: failed to load a mapping of test1.dll", curTest);
+	else
+		REPORT_PASS("%s: load mapped", curTest);
+
+	/* Not destroyed, contexts share the domain and destroying one closes test1.dll's image under the main context */
+}
+
+static void RunBundleTest(TestContext_t& context) {
+	const char* curTest = "Script bundle";
+	std::string dir = MakeTempDir();
+	std::string path = dir + "/scripts.mwbn";
+	/* Not referenced by anything loaded so far, so mono has to ask the preload hook for it */
+	const char* unreferenced = "System.Web.HttpUtility";
+	std::string unreferencedPath = RuntimeAssemblyPath("System.Web.HttpUtility.dll");
+
+	if (dir.empty() || !ManagedScriptBundle::Write(path, {"test1.dll", unreferencedPath})) {
+		REPORT_FAIL("%s: failed to write %s", curTest, path.c_str());
+		rmdir(dir.c_str());
+		return;
+	}
+
+	/* The mapping keeps the contents alive once the file is gone */
+	ManagedScriptBundle* bundle = context.scriptSystem->LoadBundle(path.c_str());
+	remove(path.c_str());
+	rmdir(dir.c_str());
+	if (!bundle || bundle->EntryCount() != 2) {
+		REPORT_FAIL("%s: failed to map %s", curTest, path.c_str());
+		return;
+	}
+	REPORT_PASS("%s: write and map", curTest);
+
+	const ScriptBundleEntry_t* entry = bundle->Find(bundle->Name(bundle->Entry(0)));
+	if (!entry || entry->size == 0 || memcmp(bundle->Data(*entry), "MZ", 2) != 0 || bundle->Find("missing") ||
+		!bundle->Find("test1") || !bundle->Find(unreferenced))
+		REPORT_FAIL("%s: entry lookup", curTest);
+	else
+		REPORT_PASS("%s: entry lookup", curTest);
+
+	/* Bundle images are named <bundle path>:<assembly>, so that's how to tell where mono got it from */
+	MonoImageOpenStatus status = MONO_IMAGE_OK;
+	MonoAssembly* ass = mono_assembly_load_with_partial_name(unreferenced, &status);
+	const char* imageName = ass ? mono_image_get_filename(mono_assembly_get_image(ass)) : nullptr;
+	if (!imageName || strncmp(imageName, path.c_str(), path.size()) != 0)
+		REPORT_FAIL("%s: reference not resolved from the bundle (%s)", curTest, imageName ? imageName : "null");
+	else
+		REPORT_PASS("%s: preload hook", curTest);
+
+	/* Separate context, which is never destroyed since it shares test1.dll's image with the main one */
+	ManagedScriptContext* ctx = context.scriptSystem->CreateContext("test1.dll");
+	ManagedAssembly* loaded = nullptr;
+	if (ctx && ctx->LoadAssemblyFromBundle(*bundle, unreferenced))
+		loaded = ctx->FindAssembly(unreferenced);
+	if (!loaded || !ctx->FindClass(*loaded, "System.Web", "HttpUtility"))
+		REPORT_FAIL("%s: LoadAssemblyFromBundle", curTest);
+	else
+		REPORT_PASS("%s: LoadAssemblyFromBundle", curTest);
+}
+
+static void RunParallelLoadTest(TestContext_t& context) {
+	const char* curTest = "Parallel assembly loading";
+	ManagedScriptContext* ctx = context.scriptContext;
+	size_t loaded = ctx->m_loadedAssemblies.size();
+
+	if (ctx->LoadAssemblies({"/nonexistent/a.dll", "/nonexistent/b.dll"}, 2) != 0 ||
+		ctx->m_loadedAssemblies.size() != loaded)
+		REPORT_FAIL("%s: missing assemblies were published", curTest);
+	else
+		REPORT_PASS("%s: missing assemblies skipped", curTest);
+
+	/* Runtime assemblies nothing else loads, in a separate context so the main search order is left alone */
+	ctx = context.scriptSystem->CreateContext("test1.dll");
+	if (!ctx) {
+		REPORT_FAIL("%s: failed to create a context", curTest);
+		return;
+	}
+	struct Expected_t
+	{
+		std::string path;
+		const char* ns;
+		const char* cls;
+	};
+	std::vector<Expected_t> expected = {
+		{RuntimeAssemblyPath("System.Collections.Immutable.dll"), "System.Collections.Immutable", "ImmutableArray"},
+		{RuntimeAssemblyPath("System.Threading.Channels.dll"), "System.Threading.Channels", "Channel"},
+		{RuntimeAssemblyPath("System.Formats.Asn1.dll"), "System.Formats.Asn1", "AsnReader"},
+	};
+	loaded = ctx->m_loadedAssemblies.size();
+	size_t count = ctx->LoadAssemblies({expected[0].path, "/nonexistent/c.dll", expected[1].path, expected[2].path}, 3);
+	if (count != expected.size() || ctx->m_loadedAssemblies.size() != loaded + expected.size()) {
+		REPORT_FAIL("%s: loaded %zu of %zu assemblies", curTest, count, expected.size());
+		return;
+	}
+
+	/* Published in the order passed in, whichever worker finished first */
+	bool ordered = true;
+	auto it = std::next(ctx->m_loadedAssemblies.begin(), loaded);
+	for (auto& e : expected) {
+		ManagedAssembly* ass = ctx->FindAssembly(e.path);
+		ordered = ordered && ass == *it++ && ctx->FindClass(*ass, e.ns, e.cls);
+	}
+	if (!ordered)
+		REPORT_FAIL("%s: assemblies published out of order or without their types", curTest);
+	else
+		REPORT_PASS("%s: real assemblies published in order", curTest);
+
+	/* Not destroyed, contexts share the domain and destroying one closes test1.dll's image under the main context */
+}
+
+static void RunObjectRefTest(TestContext_t& context) {
+	const char* curTest = "Object refs";
+	ManagedObject* obj = context.testClass->CreateInstance<void()>(nullptr);
+	if (!obj) {
+		REPORT_FAIL("%s: failed to create WrapperTests.TestClass", curTest);
+		return;
+	}
+
+	PinnedObjectRef pinned(obj->RawObject());
+	PinnedObjectRef copy = pinned;
+	if (copy.Get() != pinned.Get() || copy.GCHandle() == pinned.GCHandle())
+		REPORT_FAIL("%s: copy doesn't hold its own handle to the object", curTest);
+	else
+		REPORT_PASS("%s: pinned copy", curTest);
+
+	StrongObjectRef strong(obj->RawObject());
+	StrongObjectRef moved = std::move(strong);
+	if (strong || moved.Get() != obj->RawObject())
+		REPORT_FAIL("%s: move", curTest);
+	else
+		REPORT_PASS("%s: strong move", curTest);
+
+	ManagedObject weak(obj->RawObject(), *context.testClass, EManagedObjectHandleType::WEAKREF);
+	ManagedObject weakCopy = weak;
+	if (weakCopy.RawObject() != obj->RawObject() || weakCopy.GCHandleType() != EManagedObjectHandleType::WEAKREF)
+		REPORT_FAIL("%s: ManagedObject copy", curTest);
+	else
+		REPORT_PASS("%s: ManagedObject copy", curTest);
+	delete obj;
+}
+
+static void RunFieldAccessorTest(TestContext_t& context) {
+	const char* curTest = "Field accessors";
+	ManagedClass* cls = context.testClass;
+	ManagedObject* obj = cls->CreateInstance<void()>(nullptr);
+	if (!obj) {
+		REPORT_FAIL("%s: failed to create WrapperTests.TestClass", curTest);
+		return;
+	}
+
+	FieldAccessor<int32_t> integer(*cls->FindField("integer"));
+	FieldAccessor<MonoString*> value(*cls->FindField("value"));
+	if (!integer || !value || FieldAccessor<float>(*cls->FindField("integer")))
+		REPORT_FAIL("%s: field type checks", curTest);
+	else
+		REPORT_PASS("%s: field type checks", curTest);
+
+	integer.Set(*obj, 1234);
+	int32_t viaMono = 0;
+	obj->GetField("integer", &viaMono);
+	if (integer.Get(*obj) != 1234 || viaMono != 1234)
+		REPORT_FAIL("%s: int field round trip", curTest);
+	else
+		REPORT_PASS("%s: int field round trip", curTest);
+
+	MonoString* str = mono_string_new(mono_domain_get(), "field");
+	value.Set(*obj, str);
+	if (value.Get(*obj) != str)
+		REPORT_FAIL("%s: reference field round trip", curTest);
+	else
+		REPORT_PASS("%s: reference field round trip", curTest);
+
+	ManagedObject* other = cls->CreateInstance<void()>(nullptr);
+	ManagedObject* objects[] = {obj, nullptr, other};
+	const int32_t in[] = {1, 2, 3};
+	int32_t out[3] = {-1, -1, -1};
+	ManagedField& field = *cls->FindField("integer");
+	if (!other || !field.Scatter(objects, 3, in) || !field.Gather(objects, 3, out) || out[0] != 1 || out[1] != 0 ||
+		out[2] != 3 || field.Gather(objects, 3, reinterpret_cast<float*>(out)))
+		REPORT_FAIL("%s: gather/scatter", curTest);
+	else
+		REPORT_PASS("%s: gather/scatter", curTest);
+	delete other;
+	delete obj;
+}
+
+struct TestVec3_t
+{
+	float x, y, z;
+};
+
+/* Same size as TestVec3_t, never bound */
+struct TestInt3_t
+{
+	int32_t x, y, z;
+};
+
+/* Smaller than WrapperTests.Vec3 */
+struct TestVec2_t
+{
+	float x, y;
+};
+
+struct TestTaggedValue_t
+{
+	int32_t id;
+	struct
+	{
+		MonoString* name;
+	} tag;
+};
+
+static void RunStructBindingTest(TestContext_t& context) {
+	const char* curTest = "Struct binding";
+	ManagedClass* cls = context.scriptContext->FindClass("WrapperTests", "Vec3");
+	if (!cls) {
+		REPORT_FAIL("Failed to find WrapperTests.Vec3");
+		return;
+	}
+
+	if (BindStruct<TestVec3_t>(*cls, {MONO_STRUCT_FIELD(TestVec3_t, x), MONO_STRUCT_FIELD(TestVec3_t, z)}))
+		REPORT_FAIL("%s: partial binding accepted", curTest);
+	else
+		REPORT_PASS("%s: partial binding rejected", curTest);
+
+	if (!BindStruct<TestVec3_t>(*cls, {MONO_STRUCT_FIELD(TestVec3_t, x), MONO_STRUCT_FIELD(TestVec3_t, y),
+									   MONO_STRUCT_FIELD(TestVec3_t, z)})) {
+		REPORT_FAIL("%s: binding rejected", curTest);
+		return;
+	}
+	REPORT_PASS("%s: bind", curTest);
+
+	TestVec3_t in = {1.f, 2.f, 3.f}, out = {};
+	MonoObject* boxed = cls->Box(in);
+	if (!boxed || !cls->Unbox(boxed, out) || out.x != 1.f || out.y != 2.f || out.z != 3.f)
+		REPORT_FAIL("%s: box round trip", curTest);
+	else
+		REPORT_PASS("%s: box round trip", curTest);
+
+	TestInt3_t ints = {};
+	if (cls->Box(ints) || (boxed && cls->Unbox(boxed, ints)))
+		REPORT_FAIL("%s: boxed through a type that was never bound", curTest);
+	else
+		REPORT_PASS("%s: unbound type rejected", curTest);
+
+	/* Value type parameters all share one type enum, only their size tells them apart */
+	ManagedClass* testClass = context.scriptContext->FindClass("WrapperTests", "WrapperTestClass");
+	ManagedMethod* sum = testClass ? testClass->FindMethod("SumVec3") : nullptr;
+	if (!sum || !sum->Bind<float(TestVec3_t)>() || sum->Bind<float(TestVec2_t)>())
+		REPORT_FAIL("%s: value type parameter size", curTest);
+	else
+		REPORT_PASS("%s: value type parameter size", curTest);
+
+	/* The reference is one level down, inside a nested value type */
+	ManagedClass* tagged = context.scriptContext->FindClass("WrapperTests", "TaggedValue");
+	if (!tagged || BindStruct<TestTaggedValue_t>(*tagged, {MONO_STRUCT_FIELD(TestTaggedValue_t, id),
+														   MONO_STRUCT_FIELD(TestTaggedValue_t, tag)}))
+		REPORT_FAIL("%s: nested reference accepted", curTest);
+	else
+		REPORT_PASS("%s: nested reference rejected", curTest);
+}
+
+static void RunArrayTest(TestContext_t& context) {
+	const char* curTest = "Managed arrays";
+
+	auto ints = ManagedArray<int32_t>::New(100);
+	std::vector<int32_t> values(100);
+	for (int i = 0; i < 100; i++)
+		values[i] = i * 3;
+	if (!ints || ints.Length() != 100 || !ints.CopyFrom(values.data(), values.size()) || ints[99] != 297 ||
+		ints.CopyFrom(values.data(), 1, 100))
+		REPORT_FAIL("%s: int[] copy", curTest);
+	else
+		REPORT_PASS("%s: int[] copy", curTest);
+
+	/* Longer than one vector so both the SIMD and scalar paths run */
+	uint8_t rawBools[37];
+	for (int i = 0; i < 37; i++)
+		rawBools[i] = static_cast<uint8_t>(i % 3 == 0 ? 0 : i);
+	auto bools = ManagedArray<bool>::New(37);
+	bools.CopyFrom(reinterpret_cast<const bool*>(rawBools), 37);
+	bool boolsOk = true;
+	for (int i = 0; i < 37; i++)
+		boolsOk &= reinterpret_cast<const uint8_t*>(bools.Data())[i] == (i % 3 != 0);
+	if (!boolsOk)
+		REPORT_FAIL("%s: bool[] normalization", curTest);
+	else
+		REPORT_PASS("%s: bool[] normalization", curTest);
+
+	const char text[] = "The quick brown fox jumps over the lazy dog";
+	const size_t len = sizeof(text) - 1;
+	auto chars = ManagedArray<char16_t>::New(len);
+	char back[sizeof(text)] = {};
+	chars.CopyFromLatin1(text, len);
+	chars.Set(4, u'\u20AC');
+	chars.CopyToLatin1(back, len);
+	if (chars[0] != u'T' || back[4] != '\xFF' || back[5] != 'u' || memcmp(back + 5, text + 5, len - 5) != 0)
+		REPORT_FAIL("%s: char[] conversion", curTest);
+	else
+		REPORT_PASS("%s: char[] conversion", curTest);
+
+	/* Same element sizes on 64 bit, but one holds references and the other doesn't */
+	auto objects = ManagedArray<MonoObject*>::New(4, mono_get_object_class());
+	auto longs = ManagedArray<int64_t>::New(4);
+	if (!objects || !longs || ManagedArray<int16_t>(ints.RawArray()) || ManagedArray<int64_t>(objects.RawArray()) ||
+		ManagedArray<MonoObject*>(longs.RawArray()) || !ManagedArray<int32_t>(ints.RawArray()))
+		REPORT_FAIL("%s: mismatched element types viewed", curTest);
+	else
+		REPORT_PASS("%s: mismatched element types rejected", curTest);
+}
+
+static void RunStringTest(TestContext_t& context) {
+	const char* curTest = "String marshaling";
+	const char* text = "Plain ASCII prefix long enough to vectorize, then \xC3\xA9t\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80";
+
+	MonoString* str = NewManagedString(text);
+	std::u16string_view view = StringView(str);
+	if (!str || view.substr(0, 5) != u"Plain" || view.back() != 0xDE00 || ToUtf8(str) != text)
+		REPORT_FAIL("%s: UTF-8 round trip", curTest);
+	else
+		REPORT_PASS("%s: UTF-8 round trip", curTest);
+
+	MonoString* a = context.scriptContext->InternString("OnTick");
+	MonoString* b = context.scriptContext->InternString(std::string("On") + "Tick");
+	if (!a || a != b || ToUtf8(a) != "OnTick")
+		REPORT_FAIL("%s: interned strings", curTest);
+	else
+		REPORT_PASS("%s: interned strings", curTest);
+}
+
+static void RunConstructorTest(TestContext_t& context) {
+	const char* curTest = "Prepared constructors";
+	ManagedClass* cls = context.testClass;
+
+	if (cls->GetConstructor<void(int32_t)>())
+		REPORT_FAIL("%s: bound a constructor that doesn't exist", curTest);
+	else
+		REPORT_PASS("%s: missing constructor rejected", curTest);
+
+	auto ctor = cls->GetConstructor<void()>();
+	if (!ctor) {
+		REPORT_FAIL("%s: failed to prepare TestClass()", curTest);
+		return;
+	}
+
+	/* On the heap, where only the handles keep the objects alive through a collection */
+	std::vector<StrongObjectRef> objects(8);
+	size_t created = ctor.CreateInstances(objects.size(), objects.data());
+	mono_gc_collect(mono_gc_max_generation());
+	if (created != 8 || !objects[7] || mono_object_get_class(*objects[7]) != cls->RawClass())
+		REPORT_FAIL("%s: batch creation", curTest);
+	else
+		REPORT_PASS("%s: batch creation", curTest);
+
+	ManagedObject* obj = ctor.Create();
+	if (!obj || obj->RawObject() == *objects[0])
+		REPORT_FAIL("%s: single creation", curTest);
+	else
+		REPORT_PASS("%s: single creation", curTest);
+	delete obj;
+}
+
+static void RunExceptionViewTest(TestContext_t& context) {
+	const char* curTest = "Exception views";
+	ManagedClass* cls = context.wrapperTestClass;
+	MonoObject* obj = cls->GetConstructor<void()>().New(nullptr);
+	auto thrower = cls->FindMethod("ExeptionTest")->Bind<void(MonoObject*)>();
+	if (!obj || !thrower) {
+		REPORT_FAIL("%s: failed to set up WrapperTestClass.ExeptionTest", curTest);
+		return;
+	}
+
+	/* The callback stays registered after this test, so it can't capture locals */
+	static int reports = 0;
+	static std::string message, klass;
+	context.scriptContext->RegisterExceptionViewCallback(
+		[](ManagedScriptContext*, ManagedAssembly*, ManagedExceptionView& exc) {
+			reports++;
+			if (exc.IsException()) {
+				message = exc.Message();
+				klass = exc.ClassName();
+			}
+		});
+
+	/* Second throw reuses the cached property getters */
+	thrower(obj);
+	thrower(obj);
+	if (reports != 2 || message != "AAAAAAAAAAAAAA" || klass != "Exception")
+		REPORT_FAIL("%s: got %d reports, message '%s'", curTest, reports, message.c_str());
+	else
+		REPORT_PASS("%s: lazy message", curTest);
+}
+
+static void RunExceptionStormTest(TestContext_t& context) {
+	const char* curTest = "Exception storms";
+	ManagedClass* cls = context.wrapperTestClass;
+	MonoObject* obj = cls->GetConstructor<void()>().New(nullptr);
+	auto thrower = cls->FindMethod("ExeptionTest")->Bind<void(MonoObject*)>();
+	if (!obj || !thrower) {
+		REPORT_FAIL("%s: failed to set up WrapperTestClass.ExeptionTest", curTest);
+		return;
+	}
+
+	/* Two full reports, then nothing but counting */
+	ManagedScriptContext* ctx = context.scriptContext;
+	ManagedExceptionPolicy_t policy;
+	policy.describeFirst = 2;
+	policy.describePerSecond = 0.0f;
+	policy.throttle = true;
+	ctx->SetExceptionPolicy(policy);
+	ctx->ResetExceptionStats();
+
+	/* Runs on the reporter thread, and stays registered after this test */
+	static std::atomic<int> reports {0};
+	static std::atomic<uint64_t> lastCount {0};
+	ctx->RegisterExceptionReportCallback([](const ManagedExceptionReport_t& report) {
+		reports++;
+		lastCount = report.count;
+	});
+
+	for (int i = 0; i < 100; i++)
+		thrower(obj);
+	ctx->FlushExceptionReports();
+
+	auto stats = ctx->ExceptionStats();
+	if (stats.size() != 1 || stats[0].count != 100 || stats[0].described != 2)
+		REPORT_FAIL("%s: expected one fingerprint thrown 100 times and described twice", curTest);
+	else
+		REPORT_PASS("%s: aggregated %s.%s", curTest, stats[0].ns.c_str(), stats[0].klass.c_str());
+
+	if (reports != 2 || lastCount != 2)
+		REPORT_FAIL("%s: got %d reports off-thread", curTest, reports.load());
+	else
+		REPORT_PASS("%s: off-thread reports", curTest);
+
+	/* Several threads reporting at once must not lose counts */
+	ctx->ResetExceptionStats();
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([&]() {
+			MonoThread* thread = mono_thread_attach(ctx->RawDomain());
+			for (int i = 0; i < 50; i++)
+				thrower(obj);
+			mono_thread_detach(thread);
+		});
+	}
+	for (auto& t : threads)
+		t.join();
+	ctx->FlushExceptionReports();
+
+	stats = ctx->ExceptionStats();
+	if (stats.size() != 1 || stats[0].count != 200 || stats[0].described != 2)
+		REPORT_FAIL("%s: concurrent reports miscounted", curTest);
+	else
+		REPORT_PASS("%s: concurrent reports", curTest);
+
+	ctx->SetExceptionPolicy(ManagedExceptionPolicy_t());
+}
+
+static void RunBatchInvokeTest(TestContext_t& context) {
+	const char* curTest = "Batch invocation";
+	ManagedClass* cls = context.scriptContext->FindClass("WrapperTests", "BatchTarget");
+	ManagedMethod* tick = cls ? cls->FindMethod("Tick") : nullptr;
+	ManagedMethod* advance = cls ? cls->FindMethod("Advance") : nullptr;
+	if (!tick || !advance) {
+		REPORT_FAIL("%s: failed to find WrapperTests.BatchTarget", curTest);
+		return;
+	}
+
+	FieldAccessor<int32_t> ticks(*cls->FindField("ticks"));
+	FieldAccessor<bool> broken(*cls->FindField("broken"));
+	std::vector<ManagedObject*> objects;
+	for (int i = 0; i < 8; i++)
+		objects.push_back(cls->CreateInstance<void()>(nullptr));
+	broken.Set(*objects[3], true);
+	broken.Set(*objects[5], true);
+
+	auto skip = tick->InvokeBatch(objects);
+	if (skip.invoked != 8 || skip.failed != 2 || !skip.exceptions.empty() || ticks.Get(*objects[7]) != 1)
+		REPORT_FAIL("%s: skip policy", curTest);
+	else
+		REPORT_PASS("%s: skip policy", curTest);
+
+	auto stop = tick->InvokeBatch(objects, EBatchExceptionPolicy::STOP);
+	if (stop.invoked != 4 || stop.failed != 1 || ticks.Get(*objects[4]) != 1)
+		REPORT_FAIL("%s: stop policy", curTest);
+	else
+		REPORT_PASS("%s: stop policy", curTest);
+
+	auto collect = tick->InvokeBatch(objects, EBatchExceptionPolicy::COLLECT);
+	if (collect.failed != 2 || collect.exceptions.size() != 2 || collect.exceptions[0].index != 3 ||
+		collect.exceptions[1].index != 5 || !collect.exceptions[1].exception)
+		REPORT_FAIL("%s: collect policy", curTest);
+	else
+		REPORT_PASS("%s: collect policy", curTest);
+
+	/* Params per element, through mono_runtime_invoke */
+	std::vector<int32_t> amounts = {1, 2, 3, 4, 5, 6, 7, 8};
+	void* params[1];
+	auto args = [&](size_t i) -> void** {
+		params[0] = &amounts[i];
+		return params;
+	};
+	auto advanced = advance->InvokeBatch(objects.data(), objects.size(), args);
+	if (advanced.invoked != 8 || advanced.failed != 0 || ticks.Get(*objects[7]) != 2 + 8)
+		REPORT_FAIL("%s: per-element arguments", curTest);
+	else
+		REPORT_PASS("%s: per-element arguments", curTest);
+
+	/* Same arguments through one bound thunk */
+	auto typedArgs = [&](size_t i) { return std::make_tuple(amounts[i]); };
+	auto typed = advance->InvokeBatch<void(MonoObject*, int32_t)>(objects.data(), objects.size(), typedArgs);
+	auto mismatched = advance->InvokeBatch<void(MonoObject*, float)>(
+		objects.data(), objects.size(), [](size_t) { return std::make_tuple(1.f); });
+	if (typed.invoked != 8 || typed.failed != 0 || ticks.Get(*objects[7]) != 2 + 8 + 8 || mismatched.invoked != 0)
+		REPORT_FAIL("%s: typed arguments", curTest);
+	else
+		REPORT_PASS("%s: typed arguments", curTest);
+
+	for (auto* obj : objects)
+		delete obj;
+}
+
+/* State for WrapperTests.RegistryRemover, which calls back in here from inside Run() */
+static ManagedUpdateRegistry* g_removerRegistry = nullptr;
+static ManagedUpdateRegistry::EntryId g_removerSelf, g_removerTarget;
+static bool g_removerReenabled = false;
+/* Set to run a nested frame after the removals, which records what it saw */
+static bool g_removerNested = false;
+static ManagedBatchResult_t g_nestedFrame;
+static size_t g_nestedSize = 0;
+
+static void RemoveFromRegistry(MonoObject*) {
+	g_removerRegistry->Remove(g_removerTarget);
+	g_removerReenabled = g_removerRegistry->SetEnabled(g_removerTarget, true);
+	g_removerRegistry->Remove(g_removerSelf);
+	if (g_removerNested) {
+		g_removerNested = false;
+		g_nestedFrame = g_removerRegistry->Run();
+		g_nestedSize = g_removerRegistry->Size();
+	}
+}
+
+static void RunUpdateRegistryTest(TestContext_t& context) {
+	const char* curTest = "Update registry";
+	ManagedClass* cls = context.scriptContext->FindClass("WrapperTests", "BatchTarget");
+	if (!cls) {
+		REPORT_FAIL("%s: failed to find WrapperTests.BatchTarget", curTest);
+		return;
+	}
+
+	FieldAccessor<int32_t> ticks(*cls->FindField("ticks"));
+	FieldAccessor<bool> broken(*cls->FindField("broken"));
+	std::vector<ManagedObject*> objects;
+	for (int i = 0; i < 6; i++)
+		objects.push_back(cls->CreateInstance<void()>(nullptr));
+
+	ManagedUpdateRegistry registry("Tick");
+	std::vector<ManagedUpdateRegistry::EntryId> ids;
+	for (int i = 0; i < 6; i++)
+		ids.push_back(registry.Add(*objects[i], i % 2 ? 10 : -10));
+	ManagedObject* noTick = context.testClass->CreateInstance<void()>(nullptr);
+	if (registry.Size() != 6 || registry.Add(*noTick) != ManagedUpdateRegistry::InvalidEntry)
+		REPORT_FAIL("%s: add", curTest);
+	else
+		REPORT_PASS("%s: add", curTest);
+	delete noTick;
+
+	/* Swap-erase from the middle of a priority, then disable another */
+	registry.Remove(ids[2]);
+	registry.SetEnabled(ids[3], false);
+	auto frame = registry.Run();
+	if (frame.invoked != 4 || ticks.Get(*objects[2]) != 0 || ticks.Get(*objects[3]) != 0 ||
+		ticks.Get(*objects[4]) != 1 || registry.Size() != 5 || registry.Enabled(ids[3]))
+		REPORT_FAIL("%s: remove and disable", curTest);
+	else
+		REPORT_PASS("%s: remove and disable", curTest);
+
+	/* The -10 entries run first, so a throw in one of them stops before any 10 entry */
+	broken.Set(*objects[4], true);
+	auto stopped = registry.Run(EBatchExceptionPolicy::STOP);
+	if (stopped.failed != 1 || ticks.Get(*objects[0]) != 2 || ticks.Get(*objects[1]) != 1)
+		REPORT_FAIL("%s: priority order", curTest);
+	else
+		REPORT_PASS("%s: priority order", curTest);
+
+	auto collected = registry.Run(EBatchExceptionPolicy::COLLECT);
+	if (collected.exceptions.size() != 1 || collected.exceptions[0].index != ids[4])
+		REPORT_FAIL("%s: collected exception ids", curTest);
+	else
+		REPORT_PASS("%s: collected exception ids", curTest);
+
+	/* Entries hold their own handles */
+	for (auto* obj : objects)
+		delete obj;
+	registry.Clear();
+
+	/* Pinned, with one entry removing itself and a later one while the registry runs */
+	ManagedClass* removerClass = context.scriptContext->FindClass("WrapperTests", "RegistryRemover");
+	if (!removerClass) {
+		REPORT_FAIL("%s: failed to find WrapperTests.RegistryRemover", curTest);
+		return;
+	}
+	context.scriptSystem->RegisterNativeFunction("WrapperTests.RegistryRemover::RemoveFromRegistry",
+												 reinterpret_cast<void*>(RemoveFromRegistry));
+	ManagedObject* remover = removerClass->CreateInstance<void()>(nullptr);
+	ManagedObject* kept = cls->CreateInstance<void()>(nullptr);
+	ManagedObject* removed = cls->CreateInstance<void()>(nullptr);
+	FieldAccessor<int32_t> removerTicks(*removerClass->FindField("ticks"));
+
+	ManagedUpdateRegistry pinned("Tick", true);
+	g_removerRegistry = &pinned;
+	g_removerSelf = pinned.Add(*remover);
+	ManagedUpdateRegistry::EntryId keptId = pinned.Add(*kept);
+	g_removerTarget = pinned.Add(*removed, 10);
+
+	frame = pinned.Run();
+	if (frame.invoked != 2 || g_removerReenabled || pinned.Size() != 1 || pinned.Enabled(g_removerTarget) ||
+		ticks.Get(*removed) != 0 || ticks.Get(*kept) != 1 || removerTicks.Get(*remover) != 1)
+		REPORT_FAIL("%s: remove from inside Run", curTest);
+	else
+		REPORT_PASS("%s: remove from inside Run", curTest);
+
+	/* Only the registry's pinned handle is left on kept, so its address must survive a collection */
+	MonoObject* keptRaw = kept->RawObject();
+	delete kept;
+	mono_gc_collect(mono_gc_max_generation());
+	frame = pinned.Run();
+	if (frame.invoked != 1 || frame.nullObjects != 0 || !pinned.Enabled(keptId) || ticks.Get(keptRaw) != 2)
+		REPORT_FAIL("%s: pinned entries", curTest);
+	else
+		REPORT_PASS("%s: pinned entries", curTest);
+
+	pinned.Clear();
+
+	/* Run from inside Run: the nested frame skips the removed entries, and they are only erased once
+	 * the outer frame, still looping over them, is done */
+	ManagedObject* nestedKept = cls->CreateInstance<void()>(nullptr);
+	ManagedUpdateRegistry nested("Tick");
+	g_removerRegistry = &nested;
+	g_removerSelf = nested.Add(*remover);
+	nested.Add(*nestedKept);
+	g_removerTarget = nested.Add(*removed, 10);
+	g_removerNested = true;
+
+	frame = nested.Run();
+	if (frame.invoked != 2 || g_nestedFrame.invoked != 1 || g_nestedSize != 3 || nested.Size() != 1 ||
+		ticks.Get(*nestedKept) != 2 || ticks.Get(*removed) != 0)
+		REPORT_FAIL("%s: nested Run", curTest);
+	else
+		REPORT_PASS("%s: nested Run", curTest);
+
+	nested.Clear();
+	g_removerRegistry = nullptr;
+	delete nestedKept;
+	delete remover;
+	delete removed;
+}
+
+static void RunVirtualCallSiteTest(TestContext_t& context) {
+	const char* curTest = "Virtual call sites";
+	ManagedScriptContext* ctx = context.scriptContext;
+	ManagedClass* iface = ctx->FindClass("WrapperTests", "IBehaviour");
+	ManagedClass* classes[] = {ctx->FindClass("WrapperTests", "IdleBehaviour"),
+							   ctx->FindClass("WrapperTests", "ChaseBehaviour"),
+							   ctx->FindClass("WrapperTests", "FleeBehaviour"),
+							   ctx->FindClass("WrapperTests", "PatrolBehaviour"),
+							   ctx->FindClass("WrapperTests", "AmbushBehaviour")};
+	if (!iface || std::find(std::begin(classes), std::end(classes), nullptr) != std::end(classes)) {
+		REPORT_FAIL("%s: failed to find the behaviour classes", curTest);
+		return;
+	}
+
+	auto think = iface->FindMethod("Think")->BindVirtual<int32_t(int32_t)>();
+	if (!think || iface->FindMethod("Think")->BindVirtual<int32_t()>() ||
+		iface->FindMethod("Think")->BindVirtual<float(float)>() ||
+		iface->FindMethod("Think")->BindVirtual<int32_t(MonoString*)>()) {
+		REPORT_FAIL("%s: binding", curTest);
+		return;
+	}
+
+	ManagedObject* objects[5];
+	for (int i = 0; i < 5; i++)
+		objects[i] = classes[i]->CreateInstance<void()>(nullptr);
+
+	/* Five receiver classes take turns at the same site, each is resolved once and the rest are cache hits */
+	const int32_t expected[] = {5, 10, -5, 6, 25};
+	bool ok = true;
+	for (int frame = 0; frame < 10; frame++) {
+		for (int i = 0; i < 5; i++)
+			ok &= think(objects[i]->RawObject(), 5) == expected[i];
+	}
+	if (!ok || think.Misses() != 5)
+		REPORT_FAIL("%s: interface dispatch, %u misses", curTest, think.Misses());
+	else
+		REPORT_PASS("%s: interface dispatch", curTest);
+
+	/* Through a virtual method of a base class, and as a plain thunk */
+	auto chase = classes[1]->FindMethod("Think")->BindVirtual<int32_t(int32_t)>();
+	auto flee = chase.Target(objects[2]->RawObject());
+	if (chase(objects[1]->RawObject(), 3) != 6 || !flee || flee(objects[2]->RawObject(), 3) != -3)
+		REPORT_FAIL("%s: virtual dispatch", curTest);
+	else
+		REPORT_PASS("%s: virtual dispatch", curTest);
+
+	for (auto* obj : objects)
+		delete obj;
+}
+
+static void RunDelegateTest(TestContext_t& context) {
+	const char* curTest = "Delegates";
+	ManagedClass* cls = context.scriptContext->FindClass("WrapperTests", "DelegateSource");
+	if (!cls) {
+		REPORT_FAIL("%s: failed to find WrapperTests.DelegateSource", curTest);
+		return;
+	}
+	auto makeScaler = cls->FindMethod("MakeScaler")->Bind<MonoObject*(int32_t)>();
+	auto makeMulticast = cls->FindMethod("MakeMulticast")->Bind<MonoObject*()>();
+	auto total = cls->FindMethod("Total")->Bind<int32_t()>();
+
+	ManagedAssembly* owner = &cls->Assembly();
+	ManagedDelegate<int32_t(int32_t)> scaler(makeScaler(3), owner);
+	if (!scaler || scaler(7) != 21 || ManagedDelegate<float(float)>(scaler.RawDelegate()))
+		REPORT_FAIL("%s: typed call", curTest);
+	else
+		REPORT_PASS("%s: typed call", curTest);
+
+	/* Both targets run through the one Invoke thunk */
+	ManagedDelegate<void(int32_t), EManagedObjectHandleType::HANDLE_PINNED> multicast(makeMulticast(), owner);
+	multicast(1);
+	multicast(2);
+	if (!multicast || total() != 33)
+		REPORT_FAIL("%s: multicast, total %d", curTest, total());
+	else
+		REPORT_PASS("%s: multicast", curTest);
+
+	/* Same delegate type, the thunk is already cached */
+	auto copy = scaler;
+	ManagedDelegate<int32_t(int32_t)> other(makeScaler(-1), owner);
+	if (copy(2) != 6 || other(2) != -2)
+		REPORT_FAIL("%s: shared thunk", curTest);
+	else
+		REPORT_PASS("%s: shared thunk", curTest);
+
+	/* Every reference type hashes the same, a string must still not be passed where a TestClass is expected */
+	MonoObject* classAction = cls->FindMethod("MakeClassAction")->Bind<MonoObject*()>()();
+	if (ManagedDelegate<void(MonoString*)>(classAction) || !ManagedDelegate<void(MonoObject*)>(classAction))
+		REPORT_FAIL("%s: reference parameter types", curTest);
+	else
+		REPORT_PASS("%s: reference parameter types", curTest);
+}
+
+static void RunStaticFieldTest(TestContext_t& context) {
+	const char* curTest = "Static fields";
+	ManagedClass* cls = context.scriptContext->FindClass("WrapperTests", "StaticData");
+	if (!cls) {
+		REPORT_FAIL("%s: failed to find WrapperTests.StaticData", curTest);
+		return;
+	}
+
+	auto gravity = cls->FindField("gravity")->StaticAccessor<float>();
+	auto motd = cls->FindField("motd")->StaticAccessor<MonoString*>();
+	auto instance = cls->FindField("instance")->StaticAccessor<MonoObject*>();
+	if (!gravity || !motd || !instance || cls->FindField("gravity")->StaticAccessor<int32_t>() ||
+		cls->FindField("id")->StaticAccessor<int32_t>())
+		REPORT_FAIL("%s: field type checks", curTest);
+	else
+		REPORT_PASS("%s: field type checks", curTest);
+
+	/* Creating the accessor ran the static constructor */
+	FieldAccessor<int32_t> id(*cls->FindField("id"));
+	if (gravity.Get() != 9.8f || ToUtf8(motd.Get()) != "hello" || !instance.Get() || id.Get(instance.Get()) != 7)
+		REPORT_FAIL("%s: class init", curTest);
+	else
+		REPORT_PASS("%s: class init", curTest);
+
+	gravity.Set(1.5f);
+	MonoString* str = mono_string_new(mono_domain_get(), "goodbye");
+	motd.Set(str);
+	if (gravity.Get() != 1.5f || motd.Get() != str)
+		REPORT_FAIL("%s: round trip", curTest);
+	else
+		REPORT_PASS("%s: round trip", curTest);
+}
+
+static void RunReflectionLifetimeTest(TestContext_t& context) {
+	const char* curTest = "Reflection lifetime";
+	/* Separate context so clearing its reflection info leaves the other tests' wrappers alone */
+	ManagedScriptContext* ctx = context.scriptSystem->CreateContext("test1.dll");
+	std::string path = RuntimeAssemblyPath("System.Collections.Specialized.dll");
+	if (!ctx || !ctx->LoadAssembly(path.c_str())) {
+		REPORT_FAIL("%s: failed to load %s", curTest, path.c_str());
+		return;
+	}
+
+	auto describe = [](ManagedClass* cls, std::vector<std::string>& names) {
+		names.clear();
+		for (ManagedMethod* m : cls->Methods())
+			names.emplace_back(m->Name());
+	};
+
+	std::vector<std::string> before, after;
+	ManagedClass* cls = ctx->FindClass("System.Collections.Specialized", "StringCollection");
+	if (!cls || cls->ClassName() != "StringCollection" || cls->NamespaceName() != "System.Collections.Specialized") {
+		REPORT_FAIL("%s: failed to find StringCollection", curTest);
+		return;
+	}
+	describe(cls, before);
+
+	/* Releases every assembly arena, lookups must rebuild the wrappers from scratch */
+	ctx->ClearReflectionInfo();
+	cls = ctx->FindClass("System.Collections.Specialized", "StringCollection");
+	if (cls)
+		describe(cls, after);
+	if (!cls || before.empty() || before != after)
+		REPORT_FAIL("%s: %zu methods before clearing, %zu after", curTest, before.size(), after.size());
+	else
+		REPORT_PASS("%s: reflection rebuilt after clearing", curTest);
+
+	if (!ctx->UnloadAssembly(path) || ctx->FindAssembly(path) ||
+		ctx->FindClass("System.Collections.Specialized", "StringCollection"))
+		REPORT_FAIL("%s: assembly still reachable after unload", curTest);
+	else
+		REPORT_PASS("%s: unload", curTest);
+
+	/* Not destroyed, contexts share the domain and destroying one closes test1.dll's image under the main context */
+}